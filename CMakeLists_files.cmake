@@ -36,6 +36,8 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/timestepping/SimulatorReport.cpp
   opm/simulators/flow/countGlobalCells.cpp
   opm/simulators/flow/KeywordValidation.cpp
+  opm/simulators/flow/LocalDomainPartitioning.cpp
+  opm/simulators/linalg/ComponentSweepSolver.cpp
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.cpp
   opm/simulators/linalg/FlexibleSolver1.cpp
   opm/simulators/linalg/FlexibleSolver2.cpp
@@ -64,6 +66,8 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/wells/WellGroupHelpers.cpp
   opm/simulators/wells/WellInterfaceGeneric.cpp
   opm/simulators/wells/WellProdIndexCalculator.cpp
+  opm/simulators/wells/WellPotentialSnapshot.cpp
+  opm/simulators/wells/WellThpLimitSolver.cpp
   opm/simulators/wells/WellState.cpp
   opm/simulators/wells/WGState.cpp
   )
@@ -111,6 +115,7 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_convergencereport.cpp
   tests/test_flexiblesolver.cpp
   tests/test_preconditionerfactory.cpp
+  tests/test_componentsweepsolver.cpp
   tests/test_graphcoloring.cpp
   tests/test_vfpproperties.cpp
   tests/test_milu.cpp
@@ -123,10 +128,13 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_relpermdiagnostics.cpp
   tests/test_norne_pvt.cpp
   tests/test_wellprodindexcalculator.cpp
+  tests/test_wellpotentialsnapshot.cpp
+  tests/test_wellthplimitsolver.cpp
   tests/test_wellstate.cpp
   tests/test_parallelwellinfo.cpp
   tests/test_glift1.cpp
   tests/test_keyword_validator.cpp
+  tests/test_localdomainpartitioning.cpp
   tests/test_GroupState.cpp
   tests/test_ALQState.cpp
   )
@@ -197,6 +205,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/NonlinearSolverEbos.hpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp
   opm/simulators/flow/KeywordValidation.hpp
+  opm/simulators/flow/LocalDomainPartitioning.hpp
   opm/core/props/BlackoilPhases.hpp
   opm/core/props/phaseUsageFromDeck.hpp
   opm/core/props/satfunc/RelpermDiagnostics.hpp
@@ -229,6 +238,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/WellContributions.hpp
   opm/simulators/linalg/amgcpr.hh
   opm/simulators/linalg/twolevelmethodcpr.hh
+  opm/simulators/linalg/ComponentSweepSolver.hpp
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp
   opm/simulators/linalg/FlexibleSolver.hpp
   opm/simulators/linalg/FlexibleSolver_impl.hpp
@@ -288,6 +298,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/WellInterface.hpp
   opm/simulators/wells/WellInterface_impl.hpp
   opm/simulators/wells/WellProdIndexCalculator.hpp
+  opm/simulators/wells/WellPotentialSnapshot.hpp
+  opm/simulators/wells/WellThpLimitSolver.hpp
   opm/simulators/wells/StandardWell.hpp
   opm/simulators/wells/StandardWell_impl.hpp
   opm/simulators/wells/MultisegmentWell.hpp
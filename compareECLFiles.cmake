@@ -135,6 +135,42 @@ function(add_test_compare_parallel_simulation)
 endfunction()
 
 
+###########################################################################
+# TEST: add_test_compare_parallel_rank_output
+###########################################################################
+
+# Input:
+#   - casename: basename (no extension)
+#
+# Details:
+#   - This test class runs a parallel simulation which writes the cell data
+#     per rank and compares its summary output to the output from the serial
+#     instance of the same model.
+function(add_test_compare_parallel_rank_output)
+  set(oneValueArgs CASENAME FILENAME SIMULATOR ABS_TOL REL_TOL DIR)
+  set(multiValueArgs TEST_ARGS)
+  cmake_parse_arguments(PARAM "$" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+
+  if(NOT PARAM_DIR)
+    set(PARAM_DIR ${PARAM_CASENAME})
+  endif()
+
+  set(RESULT_PATH ${BASE_RESULT_PATH}/parallelRankOutput/${PARAM_SIMULATOR}+${PARAM_CASENAME})
+  set(TEST_ARGS ${OPM_TESTS_ROOT}/${PARAM_DIR}/${PARAM_FILENAME} ${PARAM_TEST_ARGS})
+
+  opm_add_test(compareParallelRankOutput_${PARAM_SIMULATOR}+${PARAM_FILENAME} NO_COMPILE
+               EXE_NAME ${PARAM_SIMULATOR}
+               DRIVER_ARGS ${OPM_TESTS_ROOT}/${PARAM_DIR} ${RESULT_PATH}
+                           ${PROJECT_BINARY_DIR}/bin
+                           ${PARAM_FILENAME}
+                           ${PARAM_ABS_TOL} ${PARAM_REL_TOL}
+                           ${COMPARE_ECL_COMMAND}
+               TEST_ARGS ${TEST_ARGS})
+  set_tests_properties(compareParallelRankOutput_${PARAM_SIMULATOR}+${PARAM_FILENAME}
+                       PROPERTIES RUN_SERIAL 1)
+endfunction()
+
+
 ###########################################################################
 # TEST: add_test_compare_parallel_restarted_simulation
 ###########################################################################
@@ -1095,4 +1131,12 @@ if(MPI_FOUND)
                                        REL_TOL ${rel_tol_parallel}
                                        DIR udq_actionx
                                        TEST_ARGS --linear-solver-reduction=1e-7 --tolerance-cnv=5e-6 --tolerance-mb=1e-6)
+
+  opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-parallel-rank-output-regressionTest.sh "")
+  add_test_compare_parallel_rank_output(CASENAME spe1
+                                        FILENAME SPE1CASE2
+                                        SIMULATOR flow
+                                        ABS_TOL ${abs_tol_parallel}
+                                        REL_TOL ${rel_tol_parallel}
+                                        TEST_ARGS --linear-solver-reduction=1e-7 --tolerance-cnv=5e-6 --tolerance-mb=1e-8)
 endif()
@@ -36,7 +36,12 @@
 #include <ebos/femcpgridcompat.hh>
 #endif
 
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 #include <cassert>
+#include <functional>
 #include <stdexcept>
 #include <string>
 
@@ -677,6 +682,7 @@ CollectDataToIORank(const Grid& grid, const EquilGrid* equilGrid,
                     const Dune::CartesianIndexMapper<Grid>& cartMapper,
                     const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper)
     : toIORankComm_()
+    , comm_(grid.comm())
 {
     // index maps only have to be build when reordering is needed
     if (!needsReordering && !isParallel())
@@ -787,6 +793,23 @@ CollectDataToIORank(const Grid& grid, const EquilGrid* equilGrid,
                                                 isIORank());
         toIORankComm_.exchange(distIndexMapping);
     }
+
+    if (!isParallel() || !isIORank())
+        return;
+
+    // the index maps are now translated to global indices. Store them
+    // contiguously in rank order to get a fixed layout for gathering the
+    // cell data. The last index map is the one of the I/O rank.
+    const int numRanks = comm.size();
+    cellCounts_.resize(numRanks);
+    cellDispl_.resize(numRanks + 1);
+    cellDispl_[0] = 0;
+    for (int rank = 0; rank < numRanks; ++rank) {
+        const auto& indexMap = (rank == ioRank) ? indexMaps_.back() : indexMaps_[rank - 1];
+        cellCounts_[rank] = indexMap.size();
+        cellDispl_[rank + 1] = cellDispl_[rank] + cellCounts_[rank];
+        recvIndexMap_.insert(recvIndexMap_.end(), indexMap.begin(), indexMap.end());
+    }
 }
 
 template <class Grid, class EquilGrid, class GridView>
@@ -809,21 +832,23 @@ collect(const data::Solution& localCellData,
     if(!needsReordering && !isParallel())
         return;
 
-    // this also linearises the local buffers on ioRank
-    PackUnPackCellData packUnpackCellData {
-        localCellData,
-        this->globalCellData_,
-        this->localIndexMap_,
-        this->indexMaps_,
-        this->numCells(),
-        this->isIORank()
-    };
-
     if (! isParallel()) {
+        // this linearises the local buffers on ioRank
+        PackUnPackCellData packUnpackCellData {
+            localCellData,
+            this->globalCellData_,
+            this->localIndexMap_,
+            this->indexMaps_,
+            this->numCells(),
+            this->isIORank()
+        };
+
         // no need to collect anything.
         return;
     }
 
+    this->gatherCellData_(localCellData);
+
     PackUnPackWellData packUnpackWellData {
         localWellData,
                 this->globalWellData_,
@@ -854,7 +879,6 @@ collect(const data::Solution& localCellData,
                 this->isIORank()
     };
 
-    toIORankComm_.exchange(packUnpackCellData);
     toIORankComm_.exchange(packUnpackWellData);
     toIORankComm_.exchange(packUnpackGroupAndNetworkData);
     toIORankComm_.exchange(packUnpackBlockData);
@@ -867,6 +891,66 @@ collect(const data::Solution& localCellData,
 #endif
 }
 
+template <class Grid, class EquilGrid, class GridView>
+void CollectDataToIORank<Grid,EquilGrid,GridView>::
+gatherCellData_(const data::Solution& localCellData)
+{
+    // the cell data is gathered as one record per cell which holds all
+    // fields, so every rank has to provide the same fields. This is checked
+    // collectively such that all ranks fail alike instead of some of them
+    // waiting in the gather.
+    std::size_t keyHash = localCellData.size();
+    for (const auto& pair : localCellData)
+        keyHash = keyHash * 31 + std::hash<std::string>{}(pair.first);
+
+    if (comm_.min(keyHash) != comm_.max(keyHash))
+        throw std::logic_error("The cell data to collect differs between the processes");
+
+    const int numFields = localCellData.size();
+    if (numFields == 0)
+        return;
+
+    const std::size_t localSize = localIndexMap_.size();
+    cellSendBuffer_.resize(localSize * numFields);
+    if (isIORank())
+        cellRecvBuffer_.resize(std::size_t(cellDispl_.back()) * numFields);
+
+    int fieldIdx = 0;
+    for (const auto& pair : localCellData) {
+        const auto& localData = pair.second.data;
+        for (std::size_t i = 0; i < localSize; ++i)
+            cellSendBuffer_[i*numFields + fieldIdx] = localData[localIndexMap_[i]];
+        ++fieldIdx;
+    }
+
+#if HAVE_MPI
+    // the counts and displacements are given in cell records, hence they are
+    // bounded by the number of cells regardless of the number of fields.
+    MPI_Datatype cellRecord;
+    MPI_Type_contiguous(numFields, MPI_DOUBLE, &cellRecord);
+    MPI_Type_commit(&cellRecord);
+    MPI_Gatherv(cellSendBuffer_.data(), static_cast<int>(localSize), cellRecord,
+                cellRecvBuffer_.data(), cellCounts_.data(), cellDispl_.data(), cellRecord,
+                ioRank, comm_);
+    MPI_Type_free(&cellRecord);
+#endif
+
+    if (!isIORank())
+        return;
+
+    fieldIdx = 0;
+    for (const auto& pair : localCellData) {
+        [[maybe_unused]] auto ret = globalCellData_.insert(pair.first, pair.second.dim,
+                                                           std::vector<double>(numCells()),
+                                                           pair.second.target);
+        assert(ret.second);
+        auto& data = globalCellData_.data(pair.first);
+        for (std::size_t i = 0; i < recvIndexMap_.size(); ++i)
+            data[recvIndexMap_[i]] = cellRecvBuffer_[i*numFields + fieldIdx];
+        ++fieldIdx;
+    }
+}
+
 template <class Grid, class EquilGrid, class GridView>
 int CollectDataToIORank<Grid,EquilGrid,GridView>::
 localIdxToGlobalIdx(unsigned localIdx) const
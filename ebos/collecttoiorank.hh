@@ -80,6 +80,12 @@ public:
     const data::Solution& globalCellData() const
     { return globalCellData_; }
 
+    // hand the gathered cell data over to the caller. this avoids a second
+    // global copy of every output field on the I/O rank while the data is
+    // waiting to be written.
+    data::Solution releaseGlobalCellData()
+    { return std::exchange(globalCellData_, data::Solution{}); }
+
     const data::Wells& globalWellData() const
     { return globalWellData_; }
 
@@ -105,8 +111,20 @@ public:
 
     bool isCartIdxOnThisRank(int cartIdx) const;
 
+    // local indices of the cells which are collected from this process
+    const IndexMapType& localIndexMap() const
+    { return localIndexMap_; }
+
+    // number of cells collected from each process (I/O rank only)
+    const std::vector<int>& cellCounts() const
+    { return cellCounts_; }
+
 protected:
+    // gather the cell data using the layout computed in the constructor
+    void gatherCellData_(const data::Solution& localCellData);
+
     P2PCommunicatorType toIORankComm_;
+    CollectiveCommunication comm_;
     IndexMapType globalCartesianIndex_;
     IndexMapType localIndexMap_;
     IndexMapStorageType indexMaps_;
@@ -122,6 +140,16 @@ protected:
     ///
     /// non-empty only when running in parallel
     std::vector<int> sortedCartesianIdx_;
+
+    /// \brief number of interior cells per rank (I/O rank only)
+    std::vector<int> cellCounts_;
+    /// \brief offsets of the ranks' cells in the receive buffer (I/O rank only)
+    std::vector<int> cellDispl_;
+    /// \brief global index of each cell in the receive buffer (I/O rank only)
+    IndexMapType recvIndexMap_;
+    /// \brief buffers of the cell data gather, kept to avoid reallocation
+    std::vector<double> cellSendBuffer_;
+    std::vector<double> cellRecvBuffer_;
 };
 
 } // end namespace Opm
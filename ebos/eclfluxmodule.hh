@@ -226,7 +226,7 @@ protected:
 
         Scalar trans = problem.transmissibility(elemCtx, interiorDofIdx_, exteriorDofIdx_);
         Scalar faceArea = scvf.area();
-        Scalar thpres = problem.thresholdPressure(I, J);
+        Scalar thpres = problem.thresholdPressure(elemCtx, interiorDofIdx_, exteriorDofIdx_);
 
         // estimate the gravity correction: for performance reasons we use a simplified
         // approach for this flux module that assumes that gravity is constant and always
@@ -241,12 +241,11 @@ protected:
         // solution would be to take the Z coordinate of the element centroids, but since
         // ECL seems to like to be inconsistent on that front, it needs to be done like
         // here...
-        Scalar zIn = problem.dofCenterDepth(elemCtx, interiorDofIdx_, timeIdx);
-        Scalar zEx = problem.dofCenterDepth(elemCtx, exteriorDofIdx_, timeIdx);
-
+        //
         // the distances from the DOF's depths. (i.e., the additional depth of the
-        // exterior DOF)
-        Scalar distZ = zIn - zEx;
+        // exterior DOF). The difference does not change during a run and is thus
+        // precomputed by the problem.
+        Scalar distZ = problem.dofCenterDepthDifference(elemCtx, interiorDofIdx_, exteriorDofIdx_);
 
         for (unsigned phaseIdx=0; phaseIdx < numPhases; phaseIdx++) {
             if (!FluidSystem::phaseIsActive(phaseIdx))
@@ -37,8 +37,10 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 
@@ -767,17 +769,14 @@ setRestart(const data::Solution& sol,
 }
 
 template<class FluidSystem,class Scalar>
-typename EclGenericOutputBlackoilModule<FluidSystem,Scalar>::ScalarBuffer
-EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 regionSum(const ScalarBuffer& property,
           const std::vector<int>& regionId,
-          size_t maxNumberOfRegions,
-          const Comm& comm)
+          [[maybe_unused]] size_t maxNumberOfRegions,
+          Scalar* totals)
 {
-        ScalarBuffer totals(maxNumberOfRegions, 0.0);
-
         if (property.empty())
-            return totals;
+            return;
 
         assert(regionId.size() == property.size());
         for (size_t j = 0; j < regionId.size(); ++j) {
@@ -789,11 +788,6 @@ regionSum(const ScalarBuffer& property,
             assert(regionIdx < static_cast<int>(maxNumberOfRegions));
             totals[regionIdx] += property[j];
         }
-
-        for (size_t i = 0; i < maxNumberOfRegions; ++i)
-            totals[i] = comm.sum(totals[i]);
-
-        return totals;
     }
 
 template<class FluidSystem, class Scalar>
@@ -1444,15 +1438,6 @@ outputFipLogImpl(const Inplace& inplace) const
     }
 }
 
-template<class FluidSystem,class Scalar>
-int EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-regionMax(const std::vector<int>& region,
-          const Comm& comm)
-{
-    const auto max_value = region.empty() ? 0 : *std::max_element(region.begin(), region.end());
-    return comm.max(max_value);
-}
-
 template<class FluidSystem,class Scalar>
 void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 update(Inplace& inplace,
@@ -1469,32 +1454,56 @@ update(Inplace& inplace,
     inplace.add( phase, sum );
 }
 
-template<class FluidSystem,class Scalar>
-void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-makeRegionSum(Inplace& inplace,
-              const std::string& region_name,
-              const Comm& comm)
-{
-    const auto& region = this->regions_.at(region_name);
-    std::size_t ntFip = this->regionMax(region, comm);
-
-    update(inplace, region_name, Inplace::Phase::PressurePV, ntFip, this->regionSum(this->pressureTimesPoreVolume_, region, ntFip, comm));
-    update(inplace, region_name, Inplace::Phase::HydroCarbonPV, ntFip, this->regionSum(this->hydrocarbonPoreVolume_, region, ntFip, comm));
-    update(inplace, region_name, Inplace::Phase::PressureHydroCarbonPV, ntFip, this->regionSum(this->pressureTimesHydrocarbonVolume_, region, ntFip, comm));
-
-    for (const auto& phase : Inplace::phases())
-        update(inplace, region_name, phase, ntFip, this->regionSum(this->fip_[phase], region, ntFip, comm));
-}
-
 template<class FluidSystem,class Scalar>
 Inplace EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 accumulateRegionSums(const Comm& comm)
 {
     Inplace inplace;
 
-    for (const auto& [region_name, _] : this->regions_) {
-        (void)_;
-        makeRegionSum(inplace, region_name, comm);
+    // The sums of all properties for all region sets are accumulated locally into
+    // one buffer which is then reduced with a single collective call.
+    std::vector<std::pair<Inplace::Phase, const ScalarBuffer*>> properties {
+        {Inplace::Phase::PressurePV, &this->pressureTimesPoreVolume_},
+        {Inplace::Phase::HydroCarbonPV, &this->hydrocarbonPoreVolume_},
+        {Inplace::Phase::PressureHydroCarbonPV, &this->pressureTimesHydrocarbonVolume_}
+    };
+    for (const auto& phase : Inplace::phases())
+        properties.emplace_back(phase, &this->fip_[phase]);
+
+    std::vector<int> ntFip;
+    ntFip.reserve(this->regions_.size());
+    for (const auto& [region_name, region] : this->regions_) {
+        (void)region_name;
+        ntFip.push_back(region.empty() ? 0 : *std::max_element(region.begin(), region.end()));
+    }
+    comm.max(ntFip.data(), ntFip.size());
+
+    const std::size_t numProperties = properties.size();
+    const std::size_t bufferSize = numProperties *
+        std::accumulate(ntFip.begin(), ntFip.end(), std::size_t{0});
+    ScalarBuffer totals(bufferSize, 0.0);
+    std::size_t offset = 0;
+    std::size_t regionSetIdx = 0;
+    for (const auto& [region_name, region] : this->regions_) {
+        (void)region_name;
+        const std::size_t numRegions = ntFip[regionSetIdx++];
+        for (const auto& property : properties) {
+            regionSum(*property.second, region, numRegions, totals.data() + offset);
+            offset += numRegions;
+        }
+    }
+    comm.sum(totals.data(), totals.size());
+
+    offset = 0;
+    regionSetIdx = 0;
+    for (const auto& [region_name, region] : this->regions_) {
+        (void)region;
+        const std::size_t numRegions = ntFip[regionSetIdx++];
+        for (const auto& property : properties) {
+            update(inplace, region_name, property.first, numRegions,
+                   ScalarBuffer(totals.begin() + offset, totals.begin() + offset + numRegions));
+            offset += numRegions;
+        }
     }
 
     // The first time the outputFipLog function is run we store the inplace values in
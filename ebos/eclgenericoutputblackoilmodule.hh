@@ -250,10 +250,6 @@ protected:
 
     void outputFipLogImpl(const Inplace& inplace) const;
 
-    void makeRegionSum(Inplace& inplace,
-                       const std::string& region_name,
-                       const Comm& comm);
-
     Inplace accumulateRegionSums(const Comm& comm);
 
     void updateSummaryRegionValues(const Inplace& inplace,
@@ -273,14 +269,11 @@ protected:
                                          const ScalarBuffer& pressurePv,
                                          const ScalarBuffer& pv,
                                          bool hydrocarbon);
-    // Sum Fip values over regions.
-    static ScalarBuffer regionSum(const ScalarBuffer& property,
-                                  const std::vector<int>& regionId,
-                                  size_t maxNumberOfRegions,
-                                  const Comm& comm);
-
-    static int regionMax(const std::vector<int>& region,
-                         const Comm& comm);
+    // Sum Fip values over the local part of the regions, adding to totals.
+    static void regionSum(const ScalarBuffer& property,
+                          const std::vector<int>& regionId,
+                          size_t maxNumberOfRegions,
+                          Scalar* totals);
 
     static void update(Inplace& inplace,
                        const std::string& region_name,
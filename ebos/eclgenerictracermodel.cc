@@ -31,10 +31,14 @@
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TracerVdTable.hpp>
+#include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
+#include <opm/simulators/linalg/ParallelIstlInformation.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 
 #include <dune/istl/operators.hh>
 #include <dune/istl/solvers.hh>
 #include <dune/istl/preconditioners.hh>
+#include <dune/istl/schwarz.hh>
 
 #if HAVE_DUNE_FEM
 #include <dune/fem/gridpart/adaptiveleafgridpart.hh>
@@ -42,9 +46,12 @@
 #include <ebos/femcpgridcompat.hh>
 #endif
 
+#include <algorithm>
+#include <any>
 #include <iostream>
 #include <set>
 #include <stdexcept>
+#include <utility>
 
 namespace Opm {
 
@@ -103,11 +110,24 @@ doInit(bool enabled, size_t numGridDof,
     }
 
     if (comm.size() > 1) {
-        tracerNames_.resize(0);
-        if (comm.rank() == 0)
-            std::cout << "Warning: The tracer model currently does not work for parallel runs\n"
-                      << std::flush;
-        return;
+        // the tracer system is solved with an overlapping Schwarz method
+        // which needs the parallel index information of the grid
+        std::any parallelInformation;
+        extractParallelGridInformationToISTL(gridView_.grid(), parallelInformation);
+#if HAVE_MPI
+        if (parallelInformation.type() == typeid(ParallelISTLInformation)) {
+            const auto* parinfo = std::any_cast<ParallelISTLInformation>(&parallelInformation);
+            comm_ = std::make_unique<CommunicationType>(gridView_.comm());
+            parinfo->copyValuesTo(comm_->indexSet(), comm_->remoteIndices(), numGridDof, 1);
+        }
+#endif
+        if (!comm_) {
+            tracerNames_.resize(0);
+            if (comm.rank() == 0)
+                std::cout << "Warning: The tracer model does not support parallel runs on this grid\n"
+                          << std::flush;
+            return;
+        }
     }
 
     // retrieve the number of tracers from the deck
@@ -160,7 +180,20 @@ doInit(bool enabled, size_t numGridDof,
     tracerConcentrationInitial_ = tracerConcentration_;
 
     // residual of tracers
-    tracerResidual_.resize(numGridDof);
+    tracerResidual_.resize(numTracers);
+    for (auto& residual : tracerResidual_)
+        residual.resize(numGridDof);
+
+    // group the tracers by phase
+    std::vector<int> phaseGroup(std::max({gasPhaseIdx, oilPhaseIdx, waterPhaseIdx}) + 1, -1);
+    for (size_t idx = 0; idx < numTracers; ++idx) {
+        int& groupIdx = phaseGroup[tracerPhaseIdx_[idx]];
+        if (groupIdx < 0) {
+            groupIdx = tracerGroups_.size();
+            tracerGroups_.emplace_back();
+        }
+        tracerGroups_[groupIdx].push_back(idx);
+    }
 
     // allocate matrix for storing the Jacobian of the tracer residual
     tracerMatrix_ = new TracerMatrix(numGridDof, numGridDof, TracerMatrix::random);
@@ -202,28 +235,68 @@ doInit(bool enabled, size_t numGridDof,
     }
     tracerMatrix_->endindices();
 
+    // well connections are only handled by the process owning the cell
     const int sizeCartGrid = cartMapper_.cartesianSize();
-    cartToGlobal_.resize(sizeCartGrid);
-    for (unsigned i = 0; i < numGridDof; ++i) {
-        int cartIdx = cartMapper_.cartesianIndex(i);
-        cartToGlobal_[cartIdx] = i;
+    cartToGlobal_.resize(sizeCartGrid, -1);
+    numInteriorCells_ = 0;
+    for (const auto& elem : elements(gridView_)) {
+        if (elem.partitionType() != Dune::InteriorEntity)
+            continue;
+
+        const unsigned globalDofIdx = dofMapper_.index(elem);
+        cartToGlobal_[cartMapper_.cartesianIndex(globalDofIdx)] = globalDofIdx;
+        ++numInteriorCells_;
     }
 }
 
 template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
 bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
-linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b)
+linearSolveBatched_(const TracerMatrix& M,
+                    const std::vector<int>& tracerIndices,
+                    std::vector<TracerVector>& x,
+                    std::vector<TracerVector>& b)
 {
 #if ! DUNE_VERSION_NEWER(DUNE_COMMON, 2,7)
     Dune::FMatrixPrecision<Scalar>::set_singular_limit(1.e-30);
     Dune::FMatrixPrecision<Scalar>::set_absolute_limit(1.e-30);
 #endif
-    x = 0.0;
     Scalar tolerance = 1e-2;
     int maxIter = 100;
 
     int verbosity = 0;
     using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
+
+    auto solveAll = [&](TracerSolver& solver)
+    {
+        bool converged = true;
+        for (const auto& tracerIdx : tracerIndices) {
+            x[tracerIdx] = 0.0;
+            Dune::InverseOperatorResult result;
+            solver.apply(x[tracerIdx], b[tracerIdx], result);
+            converged = converged && result.converged;
+        }
+        return converged;
+    };
+
+#if HAVE_MPI
+    if (comm_) {
+        using TracerOperator = Dune::OverlappingSchwarzOperator<TracerMatrix,TracerVector,TracerVector,CommunicationType>;
+        using TracerScalarProduct = Dune::OverlappingSchwarzScalarProduct<TracerVector,CommunicationType>;
+        using TracerPreconditioner = ParallelOverlappingILU0<TracerMatrix,TracerVector,TracerVector,CommunicationType>;
+
+        TracerOperator tracerOperator(M, *comm_);
+        TracerScalarProduct tracerScalarProduct(*comm_);
+        TracerPreconditioner tracerPreconditioner(M, *comm_, 1.0, MILU_VARIANT::ILU,
+                                                  numInteriorCells_);
+
+        TracerSolver solver (tracerOperator, tracerScalarProduct,
+                             tracerPreconditioner, tolerance, maxIter,
+                             verbosity);
+
+        return solveAll(solver);
+    }
+#endif
+
     using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
     using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
     using TracerPreconditioner = Dune::SeqILU< TracerMatrix,TracerVector,TracerVector>;
@@ -236,11 +309,38 @@ linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b)
                          tracerPreconditioner, tolerance, maxIter,
                          verbosity);
 
-    Dune::InverseOperatorResult result;
-    solver.apply(x, b, result);
-
     // return the result of the solver
-    return result.converged;
+    return solveAll(solver);
+}
+
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+sweepSolve_(const TracerMatrix& M,
+            const std::vector<int>& tracerIndices,
+            std::vector<TracerVector>& x,
+            const std::vector<TracerVector>& b)
+{
+    // the sweep is inherently sequential
+    if (comm_)
+        return false;
+
+    if (!findComponentOrdering(M, maxComponentSize_, sweepOrdering_))
+        return false;
+
+    componentSweepSolve(M, sweepOrdering_, tracerIndices, x, b);
+    return true;
+}
+
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+Scalar EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+globalNorm_(const TracerVector& x) const
+{
+#if HAVE_MPI
+    // only the owner entries contribute
+    if (comm_)
+        return comm_->norm(x);
+#endif
+    return x.two_norm();
 }
 
 #if HAVE_DUNE_FEM
@@ -32,11 +32,16 @@
 
 #include <opm/models/blackoil/blackoilmodel.hh>
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/simulators/linalg/ComponentSweepSolver.hpp>
 
 #include <dune/istl/bcrsmatrix.hh>
+#if HAVE_MPI
+#include <dune/istl/owneroverlapcopy.hh>
+#endif
 
 #include <dune/common/version.hh>
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -51,6 +56,11 @@ public:
     using TracerMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<Scalar, 1, 1>>;
     using TracerVector = Dune::BlockVector<Dune::FieldVector<Scalar,1>>;
     using CartesianIndexMapper = Dune::CartesianIndexMapper<Grid>;
+#if HAVE_MPI
+    using CommunicationType = Dune::OwnerOverlapCopyCommunication<int,int>;
+#else
+    using CommunicationType = Dune::CollectiveCommunication<int>;
+#endif
 
     /*!
      * \brief Return the number of tracers considered by the tracerModel.
@@ -83,7 +93,35 @@ protected:
                 size_t oilPhaseIdx,
                 size_t waterPhaseIdx);
 
-    bool linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b);
+    /*!
+     * \brief Solve the tracer systems of several tracers which share a matrix.
+     *
+     * The preconditioner is set up only once and is reused for the
+     * right hand sides of all tracers given by tracerIndices.
+     */
+    bool linearSolveBatched_(const TracerMatrix& M,
+                             const std::vector<int>& tracerIndices,
+                             std::vector<TracerVector>& x,
+                             std::vector<TracerVector>& b);
+
+    /*!
+     * \brief Solve the tracer systems of several tracers by a single sweep.
+     *
+     * The cells are visited in the topological order of the strongly
+     * connected components of the matrix graph, i.e., the upstream cells
+     * first. Components with more than one cell are solved directly.
+     * Returns false without touching x if a component is larger than
+     * maxComponentSize_ or for parallel runs.
+     */
+    bool sweepSolve_(const TracerMatrix& M,
+                     const std::vector<int>& tracerIndices,
+                     std::vector<TracerVector>& x,
+                     const std::vector<TracerVector>& b);
+
+    /*!
+     * \brief Return the two-norm of a tracer vector over all processes.
+     */
+    Scalar globalNorm_(const TracerVector& x) const;
 
     const GridView& gridView_;
     const EclipseState& eclState_;
@@ -95,8 +133,25 @@ protected:
     std::vector<Dune::BlockVector<Dune::FieldVector<Scalar, 1>>> tracerConcentration_;
     std::vector<Dune::BlockVector<Dune::FieldVector<Scalar, 1>>> tracerConcentrationInitial_;
     TracerMatrix *tracerMatrix_;
-    TracerVector tracerResidual_;
+    std::vector<TracerVector> tracerResidual_;
+    // indices of the tracers in each phase. the tracers of one phase
+    // share the matrix of the tracer system.
+    std::vector<std::vector<int>> tracerGroups_;
+    // index of the interior cell for each Cartesian index, -1 if the cell
+    // is not an interior cell of this process
     std::vector<int> cartToGlobal_;
+    // parallel information of the tracer system, only set for parallel runs
+    std::unique_ptr<CommunicationType> comm_;
+    // the owner cells come first, so this is the number of rows of the
+    // tracer system used by the parallel preconditioner
+    size_t numInteriorCells_ = 0;
+
+    // settings of the reordering solver
+    bool enableReordering_ = false;
+    int maxComponentSize_ = 0;
+    // the strongly connected components of the tracer system in the order
+    // they are solved by the reordering solver
+    ComponentOrdering sweepOrdering_;
     std::vector<Dune::BlockVector<Dune::FieldVector<Scalar, 1>>> storageOfTimeIndex1_;
 };
 
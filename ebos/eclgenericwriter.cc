@@ -29,11 +29,14 @@
 #include <opm/grid/polyhedralgrid.hh>
 #include <opm/grid/utility/cartesianToCompressed.hpp>
 
+#include <opm/io/eclipse/EclOutput.hpp>
+
 #include <opm/output/eclipse/EclipseIO.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
 #include <opm/output/eclipse/Summary.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/IOConfig/IOConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Action/State.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
@@ -52,6 +55,12 @@
 #include <mpi.h>
 #endif
 
+#include <algorithm>
+#include <ios>
+#include <string>
+#include <vector>
+#include <utility>
+
 namespace {
 
 /*!
@@ -114,6 +123,9 @@ struct EclWriteTasklet : public Opm::TaskletInterface
     double secondsElapsed_;
     Opm::RestartValue restartValue_;
     bool writeDoublePrecision_;
+    std::atomic<int>& numPendingWrites_;
+    std::atomic<std::size_t>& pendingWriteBytes_;
+    std::size_t payloadBytes_;
 
     explicit EclWriteTasklet(const Opm::Action::State& actionState,
                              const Opm::SummaryState& summaryState,
@@ -123,7 +135,10 @@ struct EclWriteTasklet : public Opm::TaskletInterface
                              bool isSubStep,
                              double secondsElapsed,
                              Opm::RestartValue restartValue,
-                             bool writeDoublePrecision)
+                             bool writeDoublePrecision,
+                             std::atomic<int>& numPendingWrites,
+                             std::atomic<std::size_t>& pendingWriteBytes,
+                             std::size_t payloadBytes)
         : actionState_(actionState)
         , summaryState_(summaryState)
         , udqState_(udqState)
@@ -131,8 +146,11 @@ struct EclWriteTasklet : public Opm::TaskletInterface
         , reportStepNum_(reportStepNum)
         , isSubStep_(isSubStep)
         , secondsElapsed_(secondsElapsed)
-        , restartValue_(restartValue)
+        , restartValue_(std::move(restartValue))
         , writeDoublePrecision_(writeDoublePrecision)
+        , numPendingWrites_(numPendingWrites)
+        , pendingWriteBytes_(pendingWriteBytes)
+        , payloadBytes_(payloadBytes)
     { }
 
     // callback to eclIO serial writeTimeStep method
@@ -146,9 +164,47 @@ struct EclWriteTasklet : public Opm::TaskletInterface
                              secondsElapsed_,
                              restartValue_,
                              writeDoublePrecision_);
+
+        // the cell data is not needed anymore
+        restartValue_.solution.clear();
+        pendingWriteBytes_ -= payloadBytes_;
+        --numPendingWrites_;
     }
 };
 
+// size of the cell data which is kept alive until a write request is completed
+std::size_t solutionBytes(const Opm::data::Solution& solution)
+{
+    std::size_t bytes = 0;
+    for (const auto& entry : solution)
+        bytes += entry.second.data.size() * sizeof(double);
+
+    return bytes;
+}
+
+// name of a file written next to the restart file when the cell data is
+// written per rank
+std::string perRankFileName(const Opm::IOConfig& ioConfig,
+                            const std::string& suffix,
+                            const std::string& extension)
+{
+    return ioConfig.getOutputDir() + "/" + ioConfig.getBaseName() + "-" + suffix
+        + (ioConfig.getFMTOUT() ? ".F" : ".") + extension;
+}
+
+// values of the cells collected from this process, in output precision
+template<class T>
+std::vector<T> collectedCellValues(const std::vector<double>& data,
+                                   const std::vector<int>& localIndexMap)
+{
+    std::vector<T> values;
+    values.reserve(localIndexMap.size());
+    for (const auto& localIdx : localIndexMap)
+        values.push_back(static_cast<T>(data[localIdx]));
+
+    return values;
+}
+
 }
 
 namespace Opm {
@@ -164,7 +220,10 @@ EclGenericWriter(const Schedule& schedule,
                  const Dune::CartesianIndexMapper<Grid>& cartMapper,
                  const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
                  const TransmissibilityType& globalTrans,
-                 bool enableAsyncOutput)
+                 bool enableAsyncOutput,
+                 int maxPendingWrites,
+                 double maxPendingMemory,
+                 bool outputCellDataPerRank)
     : collectToIORank_(grid,
                        equilGrid,
                        gridView,
@@ -175,10 +234,13 @@ EclGenericWriter(const Schedule& schedule,
     , schedule_(schedule)
     , eclState_(eclState)
     , summaryConfig_(summaryConfig)
+    , maxPendingWrites_(std::max(maxPendingWrites, 1))
+    , maxPendingWriteBytes_(static_cast<std::size_t>(std::max(maxPendingMemory, 0.0)*1024*1024))
     , globalTrans_(globalTrans)
     , cartMapper_(cartMapper)
     , equilCartMapper_(equilCartMapper)
     , equilGrid_(equilGrid)
+    , outputCellDataPerRank_(outputCellDataPerRank && collectToIORank_.isParallel())
 {
     if (collectToIORank_.isIORank()) {
         eclIO_.reset(new EclipseIO(eclState_,
@@ -224,6 +286,54 @@ writeInit()
         auto cartMap = cartesianToCompressed(equilGrid_->size(0),
                                              UgGridHelpers::globalCell(*equilGrid_));
         eclIO_->writeInitial(computeTrans_(cartMap), integerVectors, exportNncStructure_(cartMap));
+
+        if (outputCellDataPerRank_) {
+            // index of the files written by writeLocalCellData(): the number
+            // of cells of each rank and the rank of each global cell.
+            const auto& ioConfig = eclState_.getIOConfig();
+            EclIO::EclOutput index(perRankFileName(ioConfig, "RANKS", "INDEX"),
+                                   ioConfig.getFMTOUT());
+            index.write("NRANKS", std::vector<int>{grid_.comm().size()});
+            index.write("CELLCNT", collectToIORank_.cellCounts());
+            index.write("MPI_RANK", collectToIORank_.globalRanks());
+        }
+    }
+}
+
+template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
+void EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
+writeLocalCellData(const int reportStepNum,
+                   data::Solution&& localCellData,
+                   const bool doublePrecision)
+{
+    const auto& ioConfig = eclState_.getIOConfig();
+    const auto& localIndexMap = collectToIORank_.localIndexMap();
+
+    // the first report step written starts a new file
+    const auto mode = rankFileStarted_ ? std::ios::app : std::ios::out;
+    EclIO::EclOutput rankFile(perRankFileName(ioConfig, "RANK" + std::to_string(grid_.comm().rank()), "UNRST"),
+                              ioConfig.getFMTOUT(), mode);
+    if (!rankFileStarted_) {
+        std::vector<int> cellIdx;
+        cellIdx.reserve(localIndexMap.size());
+        for (const auto& localIdx : localIndexMap)
+            cellIdx.push_back(collectToIORank_.localIdxToGlobalIdx(localIdx));
+
+        rankFile.write("CELLIDX", cellIdx);
+        rankFileStarted_ = true;
+    }
+
+    localCellData.convertFromSI(eclState_.getUnits());
+    rankFile.write("SEQNUM", std::vector<int>{reportStepNum});
+    for (const auto& [name, cellData] : localCellData) {
+        // the keywords of the ECL files are limited to eight characters
+        if (name.size() > 8)
+            continue;
+
+        if (doublePrecision)
+            rankFile.write(name, collectedCellValues<double>(cellData.data, localIndexMap));
+        else
+            rankFile.write(name, collectedCellValues<float>(cellData.data, localIndexMap));
     }
 }
 
@@ -403,7 +513,7 @@ doWriteOutput(const int                     reportStepNum,
     const auto isParallel = this->collectToIORank_.isParallel();
 
     RestartValue restartValue {
-        isParallel ? this->collectToIORank_.globalCellData()
+        isParallel ? this->collectToIORank_.releaseGlobalCellData()
                    : std::move(localCellData),
 
         isParallel ? this->collectToIORank_.globalWellData()
@@ -424,17 +534,26 @@ doWriteOutput(const int                     reportStepNum,
     }
 
     // first, create a tasklet to write the data for the current time
-    // step to disk
+    // step to disk. the tasklet owns copies of all the data it writes.
+    const std::size_t payloadBytes = solutionBytes(restartValue.solution);
     auto eclWriteTasklet = std::make_shared<EclWriteTasklet>(
         actionState, summaryState, udqState, *this->eclIO_,
-        reportStepNum, isSubStep, curTime, std::move(restartValue), doublePrecision);
-
-    // then, make sure that the previous I/O request has been completed
-    // and the number of incomplete tasklets does not increase between
-    // time steps
-    this->taskletRunner_->barrier();
+        reportStepNum, isSubStep, curTime, std::move(restartValue), doublePrecision,
+        this->numPendingWrites_, this->pendingWriteBytes_, payloadBytes);
+
+    // then, make sure that the number of incomplete I/O requests and the
+    // memory they occupy stay bounded. the requests are processed in order
+    // by a single thread, so we wait for all of them to complete.
+    const bool tooManyWrites = this->numPendingWrites_ >= this->maxPendingWrites_;
+    const bool tooMuchMemory = this->maxPendingWriteBytes_ > 0
+        && this->numPendingWrites_ > 0
+        && this->pendingWriteBytes_ + payloadBytes > this->maxPendingWriteBytes_;
+    if (tooManyWrites || tooMuchMemory)
+        this->taskletRunner_->barrier();
 
     // finally, start a new output writing job
+    ++this->numPendingWrites_;
+    this->pendingWriteBytes_ += payloadBytes;
     this->taskletRunner_->dispatch(std::move(eclWriteTasklet));
 }
 
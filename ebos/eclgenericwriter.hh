@@ -33,6 +33,7 @@
 
 #include <opm/models/parallel/tasklets.hh>
 
+#include <atomic>
 #include <cstddef>
 #include <map>
 #include <string>
@@ -70,7 +71,10 @@ public:
                      const Dune::CartesianIndexMapper<Grid>& cartMapper,
                      const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
                      const TransmissibilityType& globalTrans,
-                     bool enableAsyncOutput);
+                     bool enableAsyncOutput,
+                     int maxPendingWrites = 1,
+                     double maxPendingMemory = 0.0,
+                     bool outputCellDataPerRank = false);
 
     const EclipseIO& eclIO() const;
 
@@ -90,6 +94,16 @@ protected:
                        Scalar nextStepSize,
                        bool doublePrecision);
 
+    /// \brief Write the cell data of the cells of this process to its own file.
+    ///
+    /// Used instead of gathering the cell data on the I/O rank when the
+    /// output of the cell data per rank is enabled. The file starts with
+    /// the global index of each cell ("CELLIDX"), followed by the report
+    /// step ("SEQNUM") and the cell data of every report step written.
+    void writeLocalCellData(int reportStepNum,
+                            data::Solution&& localCellData,
+                            bool doublePrecision);
+
     void evalSummary(int reportStepNum,
                      Scalar curTime,
                      const std::map<std::size_t, double>& wbpData,
@@ -111,6 +125,12 @@ protected:
     const EclipseState& eclState_;
     const SummaryConfig& summaryConfig_;
     std::unique_ptr<EclipseIO> eclIO_;
+    // number of output requests which are dispatched but not yet written and the
+    // size of their cell data. these need to outlive the tasklet runner.
+    std::atomic<int> numPendingWrites_{0};
+    std::atomic<std::size_t> pendingWriteBytes_{0};
+    int maxPendingWrites_;
+    std::size_t maxPendingWriteBytes_;
     std::unique_ptr<TaskletRunner> taskletRunner_;
     Scalar restartTimeStepSize_;
     const TransmissibilityType& globalTrans_;
@@ -118,6 +138,9 @@ protected:
     const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper_;
     const EquilGrid* equilGrid_;
     std::vector<std::size_t> wbp_index_list_;
+    // whether each process writes its cell data itself, only set in parallel runs
+    bool outputCellDataPerRank_;
+    bool rankFileStarted_ = false;
 
 private:
     data::Solution computeTrans_(const std::unordered_map<int,int>& cartesianToActive) const;
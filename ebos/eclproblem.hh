@@ -101,7 +101,6 @@
 #include <opm/parser/eclipse/EclipseState/Tables/OverburdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/RocktabTable.hpp>
 #include <opm/common/utility/TimeService.hpp>
-#include <opm/material/common/ConditionalStorage.hpp>
 
 #include <dune/common/version.hh>
 #include <dune/common/fvector.hh>
@@ -461,6 +460,25 @@ struct EclOutputDoublePrecision<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = false;
 };
 
+// By default, only one report step is written in the background at a time
+template<class TypeTag>
+struct EclOutputMaxPendingWrites<TypeTag, TTag::EclBaseProblem> {
+    static constexpr int value = 1;
+};
+
+// By default, the memory used by the queued ECL output is not limited
+template<class TypeTag>
+struct EclOutputMaxPendingMemory<TypeTag, TTag::EclBaseProblem> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+
+// By default, the cell data is gathered and written to the restart files
+template<class TypeTag>
+struct EclOutputCellDataPerRank<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
 // The default location for the ECL output files
 template<class TypeTag>
 struct OutputDir<TypeTag, TTag::EclBaseProblem> {
@@ -561,6 +579,17 @@ struct EnableTracerModel<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = false;
 };
 
+// solve the tracer systems with the Krylov solver by default
+template<class TypeTag>
+struct EnableTracerReordering<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
+template<class TypeTag>
+struct TracerMaxComponentSize<TypeTag, TTag::EclBaseProblem> {
+    static constexpr int value = 50;
+};
+
 // By default, simulators derived from the EclBaseProblem are production simulators,
 // i.e., experimental features must be explicitly enabled at compile time
 template<class TypeTag>
@@ -705,6 +734,11 @@ public:
                              "The frequencies of which time steps are serialized to disk");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTracerModel,
                              "Transport tracers found in the deck.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTracerReordering,
+                             "Solve the tracer equations cell by cell in the order given by the fluxes");
+        EWOMS_REGISTER_PARAM(TypeTag, int, TracerMaxComponentSize,
+                             "The largest cycle of cells solved directly by the reordering tracer solver. "
+                             "Larger cycles fall back to the Krylov solver");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EclEnableDriftCompensation,
                              "Enable partial compensation of systematic mass losses via the source term of the next time step");
         if constexpr (enableExperiments)
@@ -1148,22 +1182,18 @@ public:
             for (size_t pvtRegionIdx = 0; pvtRegionIdx < maxDRv_.size(); ++pvtRegionIdx)
                 maxDRv_[pvtRegionIdx] = oilVaporizationControl.getMaxDRVDT(pvtRegionIdx)*this->simulator().timeStepSize();
 
-        // update maximum water saturation and minimum pressure
-        // used when ROCKCOMP is activated
-        const bool invalidateFromMaxWaterSat = updateMaxWaterSaturation_();
-        const bool invalidateFromMinPressure = updateMinPressure_();
-
-        // update hysteresis and max oil saturation used in vappars
-        const bool invalidateFromHyst = updateHysteresis_();
-        const bool invalidateFromMaxOilSat = updateMaxOilSaturation_();
+        // update maximum water saturation and minimum pressure used when ROCKCOMP is
+        // activated, the hysteresis and max oil saturation used in vappars. If none of
+        // these is active, the max polymer adsorption is updated in the same sweep.
+        const bool invalidateIntensiveQuantities = updateExplicitQuantities_();
 
         // the derivatives may have change
-        bool invalidateIntensiveQuantities = invalidateFromMaxWaterSat || invalidateFromMinPressure || invalidateFromHyst || invalidateFromMaxOilSat;
-        if (invalidateIntensiveQuantities)
+        if (invalidateIntensiveQuantities) {
             this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
 
-        if (getPropValue<TypeTag, Properties::EnablePolymer>())
-            updateMaxPolymerAdsorption_();
+            if (getPropValue<TypeTag, Properties::EnablePolymer>())
+                updateMaxPolymerAdsorption_();
+        }
 
         wellModel_.beginTimeStep();
         if (enableAquifers_)
@@ -1233,12 +1263,22 @@ public:
         updateCompositionChangeLimits_();
 
         if (enableDriftCompensation_) {
+            // the drift is stored per unit of volume, i.e., the residual only needs to
+            // be scaled by the volume if it is not a volumetric one already.
             const auto& residual = this->model().linearizer().residual();
-            for (unsigned globalDofIdx = 0; globalDofIdx < residual.size(); globalDofIdx ++) {
+            const Scalar dt = simulator.timeStepSize();
+            const auto& model = this->model();
+            const int numDof = residual.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int globalDofIdx = 0; globalDofIdx < numDof; ++ globalDofIdx) {
+                Scalar factor = dt;
+                if constexpr (!getPropValue<TypeTag, Properties::UseVolumetricResidual>())
+                    factor /= model.dofTotalVolume(globalDofIdx);
+
                 drift_[globalDofIdx] = residual[globalDofIdx];
-                drift_[globalDofIdx] *= simulator.timeStepSize();
-                if (getPropValue<TypeTag, Properties::UseVolumetricResidual>())
-                    drift_[globalDofIdx] *= this->model().dofTotalVolume(globalDofIdx);
+                drift_[globalDofIdx] *= factor;
             }
         }
 
@@ -1457,7 +1497,24 @@ public:
                             unsigned toDofLocalIdx) const
     {
         assert(fromDofLocalIdx == 0);
-        return pffDofData_.get(context.element(), toDofLocalIdx).transmissibility;
+        const auto& dofData = pffDofData_.get(context.element(), toDofLocalIdx);
+        return transmissibilities_.transmissibilityFace(dofData.faceIdx);
+    }
+
+    /*!
+     * \brief Return the depth of the center of the first degree of freedom minus the one
+     *        of the second degree of freedom [m].
+     *
+     * In contrast to dofCenterDepth() this uses the per-face data which is set up once
+     * for the grid.
+     */
+    template <class Context>
+    Scalar dofCenterDepthDifference(const Context& context,
+                                    [[maybe_unused]] unsigned fromDofLocalIdx,
+                                    unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).depthDifference;
     }
 
     /*!
@@ -1469,7 +1526,8 @@ public:
                        unsigned toDofLocalIdx) const
     {
         assert(fromDofLocalIdx == 0);
-        return *pffDofData_.get(context.element(), toDofLocalIdx).diffusivity;
+        const auto& dofData = pffDofData_.get(context.element(), toDofLocalIdx);
+        return transmissibilities_.diffusivityFace(dofData.faceIdx);
     }
 
     /*!
@@ -1493,7 +1551,8 @@ public:
     {
         const auto& face = context.stencil(timeIdx).interiorFace(faceIdx);
         unsigned toDofLocalIdx = face.exteriorIndex();
-        return *pffDofData_.get(context.element(), toDofLocalIdx).thermalHalfTransIn;
+        const auto& dofData = pffDofData_.get(context.element(), toDofLocalIdx);
+        return transmissibilities_.thermalHalfTransFace(dofData.faceIdx, dofData.centerIsLower);
     }
 
     /*!
@@ -1506,7 +1565,8 @@ public:
     {
         const auto& face = context.stencil(timeIdx).interiorFace(faceIdx);
         unsigned toDofLocalIdx = face.exteriorIndex();
-        return *pffDofData_.get(context.element(), toDofLocalIdx).thermalHalfTransOut;
+        const auto& dofData = pffDofData_.get(context.element(), toDofLocalIdx);
+        return transmissibilities_.thermalHalfTransFace(dofData.faceIdx, !dofData.centerIsLower);
     }
 
     /*!
@@ -1532,6 +1592,22 @@ public:
     Scalar thresholdPressure(unsigned elem1Idx, unsigned elem2Idx) const
     { return thresholdPressures_.thresholdPressure(elem1Idx, elem2Idx); }
 
+    /*!
+     * \brief Return the threshold pressure [Pa] for the face between two degrees of
+     *        freedom.
+     *
+     * In contrast to the variant which takes the element indices, this uses the
+     * per-face data which is set up after the threshold pressures are known.
+     */
+    template <class Context>
+    Scalar thresholdPressure(const Context& context,
+                             [[maybe_unused]] unsigned fromDofLocalIdx,
+                             unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).thresholdPressure;
+    }
+
     const EclThresholdPressure<TypeTag>& thresholdPressure() const
     { return thresholdPressures_; }
 
@@ -1940,6 +2016,9 @@ public:
         // the initial solution.
         thresholdPressures_.finishInit();
 
+        // the per-face threshold pressures need to be updated as well
+        updatePffDofData_();
+
         updateCompositionChangeLimits_();
 
         if (enableAquifers_)
@@ -1964,8 +2043,9 @@ public:
         // convert the source term from the total mass rate of the
         // cell to the one per unit of volume as used by the model.
         const unsigned globalDofIdx = context.globalSpaceIndex(spaceIdx, timeIdx);
+        const Scalar invDofVolume = 1.0/this->model().dofTotalVolume(globalDofIdx);
         for (unsigned eqIdx = 0; eqIdx < numEq; ++ eqIdx) {
-            rate[eqIdx] /= this->model().dofTotalVolume(globalDofIdx);
+            rate[eqIdx] *= invDofVolume;
 
             Valgrind::CheckDefined(rate[eqIdx]);
             assert(isfinite(rate[eqIdx]));
@@ -1988,8 +2068,9 @@ public:
             Scalar poro = intQuants.referencePorosity();
             Scalar dt = simulator.timeStepSize();
 
+            // the drift is already stored per unit of volume
             EqVector dofDriftRate = drift_[globalDofIdx];
-            dofDriftRate /= dt*context.dofTotalVolume(spaceIdx, timeIdx);
+            dofDriftRate /= dt;
 
             // compute the weighted total drift rate
             Scalar totalDriftRate = 0.0;
@@ -2390,32 +2471,60 @@ private:
     }
 
 
+    // intensive quantities of the primary degree of freedom of an element. These are
+    // taken from the cache of the model if it holds them, and are only computed
+    // using the element context otherwise.
+    const IntensiveQuantities& explicitIntensiveQuantities_(ElementContext& elemCtx,
+                                                            const Element& elem,
+                                                            unsigned globalDofIdx) const
+    {
+        const auto* iq = this->model().cachedIntensiveQuantities(globalDofIdx, /*timeIdx=*/0);
+        if (iq)
+            return *iq;
+
+        elemCtx.updatePrimaryStencil(elem);
+        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+        return elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+    }
+
     // update the parameters needed for DRSDT and DRVDT
     void updateCompositionChangeLimits_()
     {
-        // update the "last Rs" values for all elements, including the ones in the ghost
-        // and overlap regions
+        const bool convective = drsdtConvective_();
+        const bool drsdt = this->drsdtActive_();
+        const bool drvdt = drvdtActive_();
+        if (!convective && !drsdt && !drvdt)
+            return;
+
+        // update the "last Rs" and "last Rv" values for all elements, including the
+        // ones in the ghost and overlap regions. All quantities are updated in a single
+        // sweep over the grid.
         const auto& simulator = this->simulator();
+        const auto& vanguard = simulator.vanguard();
+        int episodeIdx = std::max(simulator.episodeIndex(), 0);
+        const auto& oilVaporizationControl = vanguard.schedule()[episodeIdx].oilvap();
+        Scalar g = this->gravity_[dim - 1];
 
-        if (drsdtConvective_()) {
-            // This implements the convective DRSDT as described in
-            // Sandve et al. "Convective dissolution in field scale CO2 storage simulations using the OPM Flow simulator"
-            // Submitted to TCCS 11, 2021
-            Scalar g = this->gravity_[dim - 1];
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+        ElementContext elemCtx(simulator);
+        const auto& elementMapper = this->model().elementMapper();
+        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
+        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const Element& elem = *elemIt;
+
+            unsigned compressedDofIdx = elementMapper.index(elem);
+            const auto& iq = explicitIntensiveQuantities_(elemCtx, elem, compressedDofIdx);
+            const auto& fs = iq.fluidState();
+
+            using FluidState = typename std::decay<decltype(fs)>::type;
+
+            if (convective) {
+                // This implements the convective DRSDT as described in
+                // Sandve et al. "Convective dissolution in field scale CO2 storage simulations using the OPM Flow simulator"
+                // Submitted to TCCS 11, 2021
                 const DimMatrix& perm = intrinsicPermeability(compressedDofIdx);
                 const Scalar permz = perm[dim - 1][dim - 1]; // The Z permeability
                 Scalar distZ = vanguard.cellThickness(compressedDofIdx);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
                 Scalar t = getValue(fs.temperature(FluidSystem::oilPhaseIdx));
                 Scalar p = getValue(fs.pressure(FluidSystem::oilPhaseIdx));
                 Scalar so = getValue(fs.saturation(FluidSystem::oilPhaseIdx));
@@ -2432,57 +2541,19 @@ private:
                 // i.e. we only allow for fingers moving downward
                 convectiveDrs_[compressedDofIdx] = permz * rssat * max(0.0, deltaDensity) * g / ( so * visc * distZ * poro);
             }
-        }
-
-        if (this->drsdtActive_()) {
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
-
-                using FluidState = typename std::decay<decltype(fs)>::type;
 
+            if (drsdt) {
                 int pvtRegionIdx = pvtRegionIndex(compressedDofIdx);
-                int episodeIdx = std::max(simulator.episodeIndex(), 0);
-                const auto& oilVaporizationControl = simulator.vanguard().schedule()[episodeIdx].oilvap();
                 if (oilVaporizationControl.getOption(pvtRegionIdx) || fs.saturation(gasPhaseIdx) > freeGasMinSaturation_)
                     lastRs_[compressedDofIdx] =
                         BlackOil::template getRs_<FluidSystem,
                                                   FluidState,
-                                                 Scalar>(fs, iq.pvtRegionIndex());
+                                                  Scalar>(fs, iq.pvtRegionIndex());
                 else
                     lastRs_[compressedDofIdx] = std::numeric_limits<Scalar>::infinity();
             }
-        }
-
-        // update the "last Rv" values for all elements, including the ones in the ghost
-        // and overlap regions
-        if (drvdtActive_()) {
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
-
-                using FluidState = typename std::decay<decltype(fs)>::type;
 
+            if (drvdt) {
                 lastRv_[compressedDofIdx] =
                     BlackOil::template getRv_<FluidSystem,
                                               FluidState,
@@ -2491,93 +2562,67 @@ private:
         }
     }
 
-    bool updateMaxOilSaturation_()
-    {
-        const auto& simulator = this->simulator();
-
-        // we use VAPPARS
-        if (vapparsActive()) {
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
-
-                Scalar So = decay<Scalar>(fs.saturation(oilPhaseIdx));
-
-                maxOilSaturation_[compressedDofIdx] = std::max(maxOilSaturation_[compressedDofIdx], So);
-            }
-
-            // we need to invalidate the intensive quantities cache here because the
-            // derivatives of Rs and Rv will most likely have changed
-            return true;
-        }
-
-        return false;
-    }
-
-    bool updateMaxWaterSaturation_()
-    {
-        // water compaction is activated in ROCKCOMP
-        if (maxWaterSaturation_.empty())
+    // update the quantities which are treated explicitly between time steps: the
+    // maximum water saturation and the minimum pressure (ROCKCOMP), the hysteresis
+    // parameters and the maximum oil saturation (VAPPARS). These are updated in a single
+    // sweep over all elements (i.e., not just the interior ones) to avoid
+    // desynchronization of the processes in the parallel case. If none of them is
+    // active, the maximum polymer adsorption is updated in the same sweep.
+    //
+    // Returns true if the intensive quantities need to be updated afterwards.
+    bool updateExplicitQuantities_()
+    {
+        const bool updateMaxWaterSat = !maxWaterSaturation_.empty();
+        const bool updateMinPressure = !minOilPressure_.empty();
+        const bool updateHyst = materialLawManager_->enableHysteresis();
+        const bool updateMaxOilSat = vapparsActive();
+        const bool invalidate = updateMaxWaterSat || updateMinPressure || updateHyst || updateMaxOilSat;
+        const bool updatePolymer = !invalidate && getPropValue<TypeTag, Properties::EnablePolymer>();
+        if (!invalidate && !updatePolymer)
             return false;
 
-        maxWaterSaturation_[/*timeIdx=*/1] = maxWaterSaturation_[/*timeIdx=*/0];
+        if (updateMaxWaterSat)
+            maxWaterSaturation_[/*timeIdx=*/1] = maxWaterSaturation_[/*timeIdx=*/0];
+
         ElementContext elemCtx(this->simulator());
+        const auto& elementMapper = this->model().elementMapper();
         const auto& vanguard = this->simulator().vanguard();
         auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
         const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
         for (; elemIt != elemEndIt; ++elemIt) {
             const Element& elem = *elemIt;
 
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+            unsigned compressedDofIdx = elementMapper.index(elem);
+            const auto& iq = explicitIntensiveQuantities_(elemCtx, elem, compressedDofIdx);
             const auto& fs = iq.fluidState();
 
-            Scalar Sw = decay<Scalar>(fs.saturation(waterPhaseIdx));
-            maxWaterSaturation_[compressedDofIdx] = std::max(maxWaterSaturation_[compressedDofIdx], Sw);
-        }
-
-        return true;
-    }
-
-    bool updateMinPressure_()
-    {
-        // IRREVERS option is used in ROCKCOMP
-        if (minOilPressure_.empty())
-            return false;
+            if (updateMaxWaterSat) {
+                Scalar Sw = decay<Scalar>(fs.saturation(waterPhaseIdx));
+                maxWaterSaturation_[compressedDofIdx] = std::max(maxWaterSaturation_[compressedDofIdx], Sw);
+            }
 
-        ElementContext elemCtx(this->simulator());
-        const auto& vanguard = this->simulator().vanguard();
-        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
+            if (updateMinPressure)
+                minOilPressure_[compressedDofIdx] =
+                    std::min(minOilPressure_[compressedDofIdx],
+                             getValue(fs.pressure(oilPhaseIdx)));
 
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            if (updateHyst)
+                materialLawManager_->updateHysteresis(fs, compressedDofIdx);
 
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& fs = iq.fluidState();
+            if (updateMaxOilSat) {
+                Scalar So = decay<Scalar>(fs.saturation(oilPhaseIdx));
+                maxOilSaturation_[compressedDofIdx] = std::max(maxOilSaturation_[compressedDofIdx], So);
+            }
 
-            minOilPressure_[compressedDofIdx] =
-                std::min(minOilPressure_[compressedDofIdx],
-                         getValue(fs.pressure(oilPhaseIdx)));
+            if (updatePolymer)
+                maxPolymerAdsorption_[compressedDofIdx] =
+                    std::max(maxPolymerAdsorption_[compressedDofIdx],
+                             scalarValue(iq.polymerAdsorption()));
         }
 
-        return true;
+        // we need to invalidate the intensive quantities cache here because the
+        // derivatives of Rs and Rv will most likely have changed
+        return invalidate;
     }
 
     void readRockParameters_()
@@ -3163,32 +3208,6 @@ private:
         }
     }
 
-    // update the hysteresis parameters of the material laws for the whole grid
-    bool updateHysteresis_()
-    {
-        if (!materialLawManager_->enableHysteresis())
-            return false;
-
-        // we need to update the hysteresis data for _all_ elements (i.e., not just the
-        // interior ones) to avoid desynchronization of the processes in the parallel case!
-        const auto& simulator = this->simulator();
-        ElementContext elemCtx(simulator);
-        const auto& vanguard = simulator.vanguard();
-        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-            materialLawManager_->updateHysteresis(intQuants.fluidState(), compressedDofIdx);
-        }
-        return true;
-    }
-
     void updateMaxPolymerAdsorption_()
     {
         // we need to update the max polymer adsoption data for all elements
@@ -3251,10 +3270,12 @@ private:
 
     struct PffDofData_
     {
-        ConditionalStorage<enableEnergy, Scalar> thermalHalfTransIn;
-        ConditionalStorage<enableEnergy, Scalar> thermalHalfTransOut;
-        ConditionalStorage<enableDiffusion, Scalar> diffusivity;
-        Scalar transmissibility;
+        // index of the face in the face indexed storage of the transmissibilities
+        std::size_t faceIdx;
+        // whether the center element has the smaller index of the two elements
+        bool centerIsLower;
+        Scalar depthDifference;
+        Scalar thresholdPressure;
     };
 
     // update the prefetch friendly data object
@@ -3267,18 +3288,16 @@ private:
             -> void
         {
             const auto& elementMapper = this->model().elementMapper();
+            const auto& vanguard = this->simulator().vanguard();
 
             unsigned globalElemIdx = elementMapper.index(stencil.entity(localDofIdx));
             if (localDofIdx != 0) {
                 unsigned globalCenterElemIdx = elementMapper.index(stencil.entity(/*dofIdx=*/0));
-                dofData.transmissibility = transmissibilities_.transmissibility(globalCenterElemIdx, globalElemIdx);
-
-                if constexpr (enableEnergy) {
-                    *dofData.thermalHalfTransIn = transmissibilities_.thermalHalfTrans(globalCenterElemIdx, globalElemIdx);
-                    *dofData.thermalHalfTransOut = transmissibilities_.thermalHalfTrans(globalElemIdx, globalCenterElemIdx);
-                }
-                if constexpr (enableDiffusion)
-                    *dofData.diffusivity = transmissibilities_.diffusivity(globalCenterElemIdx, globalElemIdx);
+                dofData.faceIdx = transmissibilities_.faceIndex(globalCenterElemIdx, globalElemIdx);
+                dofData.centerIsLower = globalCenterElemIdx < globalElemIdx;
+                dofData.depthDifference = vanguard.cellCenterDepth(globalCenterElemIdx)
+                    - vanguard.cellCenterDepth(globalElemIdx);
+                dofData.thresholdPressure = thresholdPressures_.thresholdPressure(globalCenterElemIdx, globalElemIdx);
             }
         };
 
@@ -3512,6 +3531,7 @@ private:
     std::vector<TabulatedFunction> rockCompTransMult_;
 
     bool enableDriftCompensation_;
+    // the mass lost in the last time step per unit of volume
     GlobalEqVector drift_;
 
     EclWellModel wellModel_;
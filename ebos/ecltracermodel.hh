@@ -42,6 +42,16 @@ struct EnableTracerModel {
     using type = UndefinedProperty;
 };
 
+template<class TypeTag, class MyTypeTag>
+struct EnableTracerReordering {
+    using type = UndefinedProperty;
+};
+
+template<class TypeTag, class MyTypeTag>
+struct TracerMaxComponentSize {
+    using type = UndefinedProperty;
+};
+
 } // namespace Opm::Properties
 
 namespace Opm {
@@ -50,8 +60,6 @@ namespace Opm {
  * \ingroup EclBlackOilSimulator
  *
  * \brief A class which handles tracers as specified in by ECL
- *
- * TODO: MPI parallelism.
  */
 template <class TypeTag>
 class EclTracerModel : public EclGenericTracerModel<GetPropType<TypeTag, Properties::Grid>,
@@ -101,6 +109,8 @@ public:
         bool enabled = EWOMS_GET_PARAM(TypeTag, bool, EnableTracerModel);
         this->doInit(enabled, simulator_.model().numGridDof(),
                      gasPhaseIdx, oilPhaseIdx, waterPhaseIdx);
+        this->enableReordering_ = EWOMS_GET_PARAM(TypeTag, bool, EnableTracerReordering);
+        this->maxComponentSize_ = EWOMS_GET_PARAM(TypeTag, int, TracerMaxComponentSize);
     }
 
     void beginTimeStep()
@@ -133,16 +143,32 @@ public:
         if (this->numTracers()==0)
             return;
 
-        for (int tracerIdx = 0; tracerIdx < this->numTracers(); ++ tracerIdx){
+        // the tracer matrix only depends on the flow field of the tracer
+        // phase, so all tracers of a phase are solved together
+        std::vector<typename BaseType::TracerVector> dx(this->numTracers());
+        for (const auto& tracerIndices : this->tracerGroups_) {
+            for (const auto& tracerIdx : tracerIndices)
+                dx[tracerIdx].resize(this->tracerResidual_[tracerIdx].size());
 
-            typename BaseType::TracerVector dx(this->tracerResidual_.size());
             // Newton step (currently the system is linear, converge in one iteration)
             for (int iter = 0; iter < 5; ++ iter){
-                linearize_(tracerIdx);
-                this->linearSolve_(*this->tracerMatrix_, dx, this->tracerResidual_);
-                this->tracerConcentration_[tracerIdx] -= dx;
-
-                if (dx.two_norm()<1e-2)
+                linearize_(tracerIndices);
+
+                // the reordering solver solves the linear system exactly
+                const bool exact = this->enableReordering_
+                    && this->sweepSolve_(*this->tracerMatrix_, tracerIndices,
+                                         dx, this->tracerResidual_);
+                if (!exact)
+                    this->linearSolveBatched_(*this->tracerMatrix_, tracerIndices,
+                                              dx, this->tracerResidual_);
+
+                bool converged = true;
+                for (const auto& tracerIdx : tracerIndices) {
+                    this->tracerConcentration_[tracerIdx] -= dx[tracerIdx];
+                    converged = converged && this->globalNorm_(dx[tracerIdx]) < 1e-2;
+                }
+
+                if (exact || converged)
                     break;
             }
         }
@@ -167,6 +193,23 @@ public:
     { /* not implemented */ }
 
 protected:
+    // evaluate the volume of the tracer phase per unit pore volume in a single cell
+    Scalar computeVolume_(const ElementContext& elemCtx,
+                          unsigned scvIdx,
+                          unsigned timeIdx,
+                          const int tracerPhaseIdx) const
+    {
+        const auto& intQuants = elemCtx.intensiveQuantities(scvIdx, timeIdx);
+        const auto& fs = intQuants.fluidState();
+        Scalar phaseVolume =
+            decay<Scalar>(fs.saturation(tracerPhaseIdx))
+            *decay<Scalar>(fs.invB(tracerPhaseIdx))
+            *decay<Scalar>(intQuants.porosity());
+
+        // avoid singular matrix if no water is present.
+        return max(phaseVolume, 1e-10);
+    }
+
     // evaluate storage term for all tracers in a single cell
     template <class LhsEval>
     void computeStorage_(LhsEval& tracerStorage,
@@ -177,15 +220,7 @@ protected:
     {
         int globalDofIdx = elemCtx.globalSpaceIndex(scvIdx, timeIdx);
 
-        const auto& intQuants = elemCtx.intensiveQuantities(scvIdx, timeIdx);
-        const auto& fs = intQuants.fluidState();
-        Scalar phaseVolume =
-            decay<Scalar>(fs.saturation(this->tracerPhaseIdx_[tracerIdx]))
-            *decay<Scalar>(fs.invB(this->tracerPhaseIdx_[tracerIdx]))
-            *decay<Scalar>(intQuants.porosity());
-
-        // avoid singular matrix if no water is present.
-        phaseVolume = max(phaseVolume, 1e-10);
+        Scalar phaseVolume = computeVolume_(elemCtx, scvIdx, timeIdx, this->tracerPhaseIdx_[tracerIdx]);
 
         if (std::is_same<LhsEval, Scalar>::value)
             tracerStorage = phaseVolume * this->tracerConcentrationInitial_[tracerIdx][globalDofIdx];
@@ -195,47 +230,16 @@ protected:
                     * variable<LhsEval>(this->tracerConcentration_[tracerIdx][globalDofIdx][0], 0);
     }
 
-    // evaluate the tracerflux over one face
-    void computeFlux_(TracerEvaluation & tracerFlux,
-                      const ElementContext& elemCtx,
-                      unsigned scvfIdx,
-                      unsigned timeIdx,
-                      const int tracerIdx)
-
-    {
-        const auto& stencil = elemCtx.stencil(timeIdx);
-        const auto& scvf = stencil.interiorFace(scvfIdx);
-
-        const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, timeIdx);
-        unsigned inIdx = extQuants.interiorIndex();
-
-        const int tracerPhaseIdx = this->tracerPhaseIdx_[tracerIdx];
-
-        unsigned upIdx = extQuants.upstreamIndex(tracerPhaseIdx);
-        int globalUpIdx = elemCtx.globalSpaceIndex(upIdx, timeIdx);
-
-        const auto& intQuants = elemCtx.intensiveQuantities(upIdx, timeIdx);
-        const auto& fs = intQuants.fluidState();
-
-        Scalar A = scvf.area();
-        Scalar v = decay<Scalar>(extQuants.volumeFlux(tracerPhaseIdx));
-        Scalar b = decay<Scalar>(fs.invB(this->tracerPhaseIdx_[tracerIdx]));
-        Scalar c = this->tracerConcentration_[tracerIdx][globalUpIdx];
-
-        if (inIdx == upIdx)
-            tracerFlux = A*v*b*variable<TracerEvaluation>(c, 0);
-        else
-            tracerFlux = A*v*b*c;
-
-    }
-
-    void linearize_(int tracerIdx)
+    // assemble the matrix shared by a group of tracers of the same phase and
+    // the residuals of all these tracers
+    void linearize_(const std::vector<int>& tracerIndices)
     {
         (*this->tracerMatrix_) = 0.0;
-        this->tracerResidual_ = 0.0;
+        for (const auto& tracerIdx : tracerIndices)
+            this->tracerResidual_[tracerIdx] = 0.0;
+
+        const int tracerPhaseIdx = this->tracerPhaseIdx_[tracerIndices.front()];
 
-        size_t numGridDof =  simulator_.model().numGridDof();
-        std::vector<double> volumes(numGridDof, 0.0);
         ElementContext elemCtx(simulator_);
         auto elemIt = simulator_.gridView().template begin</*codim=*/0>();
         auto elemEndIt = simulator_.gridView().template end</*codim=*/0>();
@@ -253,29 +257,49 @@ protected:
             Scalar dt = elemCtx.simulator().timeStepSize();
 
             size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/0);
-            volumes[I] = scvVolume;
-            TracerEvaluation localStorage;
-            TracerEvaluation storageOfTimeIndex0;
-            Scalar storageOfTimeIndex1;
-            computeStorage_(storageOfTimeIndex0, elemCtx, 0, /*timIdx=*/0, tracerIdx);
-            if (elemCtx.enableStorageCache())
-                storageOfTimeIndex1 = this->storageOfTimeIndex1_[tracerIdx][I];
-            else
-                computeStorage_(storageOfTimeIndex1, elemCtx, 0, /*timIdx=*/1, tracerIdx);
-
-            localStorage = (storageOfTimeIndex0 - storageOfTimeIndex1) * scvVolume/dt;
-            this->tracerResidual_[I][0] += localStorage.value(); //residual + flux
-            (*this->tracerMatrix_)[I][I][0][0] = localStorage.derivative(0);
+
+            // the storage term is linear in the concentration
+            Scalar storageFactor = computeVolume_(elemCtx, 0, /*timIdx=*/0, tracerPhaseIdx) * scvVolume/dt;
+            (*this->tracerMatrix_)[I][I][0][0] = storageFactor;
+            for (const auto& tracerIdx : tracerIndices) {
+                Scalar storageOfTimeIndex1;
+                if (elemCtx.enableStorageCache())
+                    storageOfTimeIndex1 = this->storageOfTimeIndex1_[tracerIdx][I];
+                else
+                    computeStorage_(storageOfTimeIndex1, elemCtx, 0, /*timIdx=*/1, tracerIdx);
+
+                this->tracerResidual_[tracerIdx][I][0] +=
+                    storageFactor*this->tracerConcentration_[tracerIdx][I][0] - storageOfTimeIndex1*scvVolume/dt;
+            }
+
             size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
             for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; scvfIdx++) {
-                TracerEvaluation flux;
                 const auto& face = elemCtx.stencil(0).interiorFace(scvfIdx);
                 unsigned j = face.exteriorIndex();
                 unsigned J = elemCtx.globalSpaceIndex(/*dofIdx=*/ j, /*timIdx=*/0);
-                computeFlux_(flux, elemCtx, scvfIdx, 0, tracerIdx);
-                this->tracerResidual_[I][0] += flux.value(); //residual + flux
-                (*this->tracerMatrix_)[J][I][0][0] = -flux.derivative(0);
-                (*this->tracerMatrix_)[I][J][0][0] = flux.derivative(0);
+
+                // evaluate the tracer flux over the face. it is the
+                // upstream concentration times a factor common to all tracers
+                const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, /*timeIdx=*/0);
+                unsigned inIdx = extQuants.interiorIndex();
+                unsigned upIdx = extQuants.upstreamIndex(tracerPhaseIdx);
+                int globalUpIdx = elemCtx.globalSpaceIndex(upIdx, /*timeIdx=*/0);
+                const auto& fs = elemCtx.intensiveQuantities(upIdx, /*timeIdx=*/0).fluidState();
+
+                Scalar A = face.area();
+                Scalar v = decay<Scalar>(extQuants.volumeFlux(tracerPhaseIdx));
+                Scalar b = decay<Scalar>(fs.invB(tracerPhaseIdx));
+                Scalar fluxFactor = A*v*b;
+
+                for (const auto& tracerIdx : tracerIndices)
+                    this->tracerResidual_[tracerIdx][I][0] +=
+                        fluxFactor*this->tracerConcentration_[tracerIdx][globalUpIdx][0]; //residual + flux
+
+                // each row is only written by its own element
+                if (inIdx == upIdx)
+                    (*this->tracerMatrix_)[I][I][0][0] += fluxFactor;
+                else
+                    (*this->tracerMatrix_)[I][J][0][0] = fluxFactor;
             }
 
         }
@@ -283,12 +307,15 @@ protected:
         // Wells
         const int episodeIdx = simulator_.episodeIndex();
         const auto& wells = simulator_.vanguard().schedule().getWells(episodeIdx);
+        std::vector<double> wtracer(tracerIndices.size());
         for (const auto& well : wells) {
 
             if (well.getStatus() == Well::Status::SHUT)
                 continue;
 
-            const double wtracer = well.getTracerProperties().getConcentration(this->tracerNames_[tracerIdx]);
+            for (size_t i = 0; i < tracerIndices.size(); ++i)
+                wtracer[i] = well.getTracerProperties().getConcentration(this->tracerNames_[tracerIndices[i]]);
+
             std::array<int, 3> cartesianCoordinate;
             for (auto& connection : well.getConnections()) {
 
@@ -300,11 +327,19 @@ protected:
                 cartesianCoordinate[2] = connection.getK();
                 const size_t cartIdx = simulator_.vanguard().cartesianIndex(cartesianCoordinate);
                 const int I = this->cartToGlobal_[cartIdx];
-                Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, this->tracerPhaseIdx_[tracerIdx]);
-                if (rate > 0)
-                    this->tracerResidual_[I][0] -= rate*wtracer;
-                else if (rate < 0)
-                    this->tracerResidual_[I][0] -= rate*this->tracerConcentration_[tracerIdx][I];
+                if (I < 0)
+                    continue;
+
+                Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, tracerPhaseIdx);
+                for (size_t i = 0; i < tracerIndices.size(); ++i) {
+                    const int tracerIdx = tracerIndices[i];
+                    if (rate > 0)
+                        this->tracerResidual_[tracerIdx][I][0] -= rate*wtracer[i];
+                    else if (rate < 0)
+                        this->tracerResidual_[tracerIdx][I][0] -= rate*this->tracerConcentration_[tracerIdx][I];
+                }
+                if (rate < 0)
+                    (*this->tracerMatrix_)[I][I][0][0] -= rate;
             }
         }
     }
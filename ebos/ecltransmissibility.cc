@@ -47,32 +47,15 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 
 namespace {
 
 constexpr unsigned elemIdxShift = 32; // bits
 
-std::uint64_t isId(std::uint32_t elemIdx1, std::uint32_t elemIdx2)
-{
-    std::uint32_t elemAIdx = std::min(elemIdx1, elemIdx2);
-    std::uint64_t elemBIdx = std::max(elemIdx1, elemIdx2);
-
-    return (elemBIdx<<elemIdxShift) + elemAIdx;
-}
-
-std::pair<std::uint32_t, std::uint32_t> isIdReverse(const std::uint64_t& id)
-{
-    // Assigning an unsigned integer to a narrower type discards the most significant bits.
-    // See "The C programming language", section A.6.2.
-    // NOTE that the ordering of element A and B may have changed
-    std::uint32_t elemAIdx = id;
-    std::uint32_t elemBIdx = (id - elemAIdx) >> elemIdxShift;
-
-    return std::make_pair(elemAIdx, elemBIdx);
-}
-
 std::uint64_t directionalIsId(std::uint32_t elemIdx1, std::uint32_t elemIdx2)
 {
     return (std::uint64_t(elemIdx1)<<elemIdxShift) + elemIdx2;
@@ -107,7 +90,7 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 transmissibility(unsigned elemIdx1, unsigned elemIdx2) const
 {
-    return trans_.at(isId(elemIdx1, elemIdx2));
+    return trans_[checkedFaceIndex_(elemIdx1, elemIdx2)];
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -121,7 +104,9 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 thermalHalfTrans(unsigned insideElemIdx, unsigned outsideElemIdx) const
 {
-    return thermalHalfTrans_.at(directionalIsId(insideElemIdx, outsideElemIdx));
+    // the first value of a face belongs to the element with the smaller index
+    const std::size_t faceIdx = checkedFaceIndex_(insideElemIdx, outsideElemIdx);
+    return thermalHalfTrans_.at(2*faceIdx + (insideElemIdx > outsideElemIdx ? 1 : 0));
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -138,10 +123,40 @@ diffusivity(unsigned elemIdx1, unsigned elemIdx2) const
     if (diffusivity_.empty())
         return 0.0;
 
-    return diffusivity_.at(isId(elemIdx1, elemIdx2));
+    return diffusivity_[checkedFaceIndex_(elemIdx1, elemIdx2)];
 
 }
 
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+std::size_t EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+faceIndex_(unsigned elemIdx1, unsigned elemIdx2) const
+{
+    const unsigned low = std::min(elemIdx1, elemIdx2);
+    const unsigned high = std::max(elemIdx1, elemIdx2);
+    if (std::size_t(low) + 1 >= faceRowStart_.size())
+        return faceNeighbor_.size();
+
+    const auto rowBegin = faceNeighbor_.begin() + faceRowStart_[low];
+    const auto rowEnd = faceNeighbor_.begin() + faceRowStart_[low + 1];
+    const auto candidate = std::lower_bound(rowBegin, rowEnd, high);
+    if (candidate == rowEnd || *candidate != high)
+        return faceNeighbor_.size();
+
+    return candidate - faceNeighbor_.begin();
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+std::size_t EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+checkedFaceIndex_(unsigned elemIdx1, unsigned elemIdx2) const
+{
+    const std::size_t faceIdx = faceIndex_(elemIdx1, elemIdx2);
+    if (faceIdx == faceNeighbor_.size())
+        throw std::out_of_range("No face between elements " + std::to_string(elemIdx1)
+                                + " and " + std::to_string(elemIdx2));
+
+    return faceIdx;
+}
+
 template<class Grid, class GridView, class ElementMapper, class Scalar>
 void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 update(bool global)
@@ -189,29 +204,15 @@ update(bool global)
                 axisCentroids[axisIdx][elemIdx][dimIdx] = centroid[dimIdx];
     }
 
-    // reserving some space in the hashmap upfront saves quite a bit of time because
-    // resizes are costly for hashmaps and there would be quite a few of them if we
-    // would not have a rough idea of how large the final map will be (the rough idea
-    // is a conforming Cartesian grid).
-    trans_.clear();
-    trans_.reserve(numElements*3*1.05);
-
     transBoundary_.clear();
 
-    // if energy is enabled, let's do the same for the "thermal half transmissibilities"
-    if (enableEnergy_) {
-        thermalHalfTrans_.clear();
-        thermalHalfTrans_.reserve(numElements*6*1.05);
-
+    // if energy is enabled, the "thermal half transmissibilities" are needed as well
+    if (enableEnergy_)
         thermalHalfTransBoundary_.clear();
-    }
 
-    // if diffusion is enabled, let's do the same for the "diffusivity"
-    if (updateDiffusivity) {
-        diffusivity_.clear();
-        diffusivity_.reserve(numElements*3*1.05);
+    // if diffusion is enabled, we need the porosity for the "diffusivity"
+    if (updateDiffusivity)
         extractPorosity_();
-    }
 
     // The MULTZ needs special case if the option is ALL
     // Then the smallest multiplier is applied.
@@ -225,6 +226,13 @@ update(bool global)
         comm.broadcast(&useSmallestMultiplier, 1, 0);
     }
 
+    // The geometric part of the transmissibilities is computed while traversing the
+    // grid. The face transmissibility multipliers only need the indices of the
+    // elements and faces involved and are applied afterwards, possibly using
+    // multiple threads. Finally the values are moved to the face indexed storage.
+    std::vector<FaceTrans> faceTrans;
+    faceTrans.reserve(numElements*3*1.05);
+
     // compute the transmissibilities for all intersections
     elemIt = gridView_.template begin</*codim=*/ 0>();
     for (; elemIt != elemEndIt; ++elemIt) {
@@ -308,7 +316,10 @@ update(bool global)
                 // NNC. Set zero transmissibility, as it will be
                 // *added to* by applyNncToGridTrans_() later.
                 assert(outsideFaceIdx == -1);
-                trans_[isId(elemIdx, outsideElemIdx)] = 0.0;
+                faceTrans.push_back({elemIdx, outsideElemIdx,
+                                     insideCartElemIdx, outsideCartElemIdx,
+                                     insideFaceIdx, outsideFaceIdx,
+                                     FaceDir::XPlus, 0.0, 0.0, 0.0, 0.0});
                 continue;
             }
 
@@ -359,25 +370,8 @@ update(bool global)
             else
                 trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
 
-            // apply the full face transmissibility multipliers
-            // for the inside ...
-
-            if (useSmallestMultiplier)
-            {
-                // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
-                // and in this branch PINCH(5) == ALL holds
-                applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
-                                      outsideCartElemIdx, transMult, cartDims,
-                                      /* pinchTop= */ false);
-            }
-            else
-            {
-                applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
-                // ... and outside elements
-                applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
-            }
-
-            // apply the region multipliers (cf. the MULTREGT keyword)
+            // determine the face direction for the region multipliers
+            // (cf. the MULTREGT keyword)
             FaceDir::DirEnum faceDir;
             switch (insideFaceIdx) {
             case 0:
@@ -399,11 +393,12 @@ update(bool global)
                 throw std::logic_error("Could not determine a face direction");
             }
 
-            trans *= transMult.getRegionMultiplier(insideCartElemIdx,
-                                                   outsideCartElemIdx,
-                                                   faceDir);
-
-            trans_[isId(elemIdx, outsideElemIdx)] = trans;
+            // the multipliers are applied for all faces at once below
+            faceTrans.push_back({elemIdx, outsideElemIdx,
+                                 insideCartElemIdx, outsideCartElemIdx,
+                                 insideFaceIdx, outsideFaceIdx,
+                                 faceDir, trans, 0.0, 0.0, 0.0});
+            auto& face = faceTrans.back();
 
             // update the "thermal half transmissibility" for the intersection
             if (enableEnergy_) {
@@ -426,8 +421,8 @@ update(bool global)
                                                         axisCentroids),
                                         1.0);
                 //TODO Add support for multipliers
-                thermalHalfTrans_[directionalIsId(elemIdx, outsideElemIdx)] = halfDiffusivity1;
-                thermalHalfTrans_[directionalIsId(outsideElemIdx, elemIdx)] = halfDiffusivity2;
+                face.thermalHalfTransIn = halfDiffusivity1;
+                face.thermalHalfTransOut = halfDiffusivity2;
            }
 
             // update the "diffusive half transmissibility" for the intersection
@@ -463,11 +458,46 @@ update(bool global)
                     diffusivity = 1.0 / (1.0/halfDiffusivity1 + 1.0/halfDiffusivity2);
 
 
-                diffusivity_[isId(elemIdx, outsideElemIdx)] = diffusivity;
+                face.diffusivity = diffusivity;
            }
         }
     }
 
+    // apply the full face transmissibility multipliers. The multipliers are only read
+    // here, hence the faces can be processed independently of each other.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t faceIdx = 0; faceIdx < faceTrans.size(); ++faceIdx) {
+        auto& face = faceTrans[faceIdx];
+        if (face.insideFaceIdx == -1)
+            continue; // NNC
+
+        if (useSmallestMultiplier)
+        {
+            // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
+            // and in this branch PINCH(5) == ALL holds
+            applyAllZMultipliers_(face.trans, face.insideFaceIdx, face.outsideFaceIdx,
+                                  face.insideCartElemIdx, face.outsideCartElemIdx,
+                                  transMult, cartDims,
+                                  /* pinchTop= */ false);
+        }
+        else
+        {
+            // for the inside ...
+            applyMultipliers_(face.trans, face.insideFaceIdx, face.insideCartElemIdx, transMult);
+            // ... and outside elements
+            applyMultipliers_(face.trans, face.outsideFaceIdx, face.outsideCartElemIdx, transMult);
+        }
+
+        // apply the region multipliers (cf. the MULTREGT keyword)
+        face.trans *= transMult.getRegionMultiplier(face.insideCartElemIdx,
+                                                    face.outsideCartElemIdx,
+                                                    face.faceDir);
+    }
+
+    buildFaceStorage_(faceTrans, numElements, updateDiffusivity);
+
     // potentially overwrite and/or modify  transmissibilities based on input from deck
     updateFromEclState_(global);
 
@@ -555,21 +585,82 @@ void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 removeSmallNonCartesianTransmissibilities_()
 {
     const auto& cartDims = cartMapper_.cartesianDimensions();
-    for (auto&& trans: trans_) {
-        if (trans.second < transmissibilityThreshold_) {
-            const auto& id = trans.first;
-            const auto& elements = isIdReverse(id);
-            int gc1 = std::min(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-            int gc2 = std::max(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-
-            // only adjust the NNCs
-            if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1])
-                continue;
+    for (unsigned elemIdx = 0; elemIdx + 1 < faceRowStart_.size(); ++elemIdx) {
+        for (unsigned faceIdx = faceRowStart_[elemIdx]; faceIdx < faceRowStart_[elemIdx + 1]; ++faceIdx) {
+            if (trans_[faceIdx] < transmissibilityThreshold_) {
+                const unsigned neighborIdx = faceNeighbor_[faceIdx];
+                int gc1 = std::min(cartMapper_.cartesianIndex(elemIdx), cartMapper_.cartesianIndex(neighborIdx));
+                int gc2 = std::max(cartMapper_.cartesianIndex(elemIdx), cartMapper_.cartesianIndex(neighborIdx));
+
+                // only adjust the NNCs
+                if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1])
+                    continue;
+
+                //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
+                trans_[faceIdx] = 0.0;
+            }
+        }
+    }
+}
 
-            //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
-            trans.second = 0.0;
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+buildFaceStorage_(const std::vector<FaceTrans>& faceTrans,
+                  unsigned numElements,
+                  bool updateDiffusivity)
+{
+    // sort the faces by the smaller and then by the larger element index. The sort
+    // is stable, hence the face visited last wins if two elements share more than
+    // one intersection.
+    auto key = [](const FaceTrans& face)
+    {
+        return directionalIsId(std::min(face.insideElemIdx, face.outsideElemIdx),
+                               std::max(face.insideElemIdx, face.outsideElemIdx));
+    };
+    std::vector<std::pair<std::uint64_t, std::size_t>> order;
+    order.reserve(faceTrans.size());
+    for (std::size_t idx = 0; idx < faceTrans.size(); ++idx)
+        order.emplace_back(key(faceTrans[idx]), idx);
+
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    faceRowStart_.assign(numElements + 1, 0);
+    faceNeighbor_.clear();
+    faceNeighbor_.reserve(order.size());
+    trans_.clear();
+    trans_.reserve(order.size());
+    thermalHalfTrans_.clear();
+    if (enableEnergy_)
+        thermalHalfTrans_.reserve(2*order.size());
+    diffusivity_.clear();
+    if (updateDiffusivity)
+        diffusivity_.reserve(order.size());
+
+    for (std::size_t orderIdx = 0; orderIdx < order.size(); ++orderIdx) {
+        if (orderIdx + 1 < order.size() && order[orderIdx + 1].first == order[orderIdx].first)
+            continue;
+
+        const auto& face = faceTrans[order[orderIdx].second];
+        const unsigned low = std::min(face.insideElemIdx, face.outsideElemIdx);
+        const unsigned high = std::max(face.insideElemIdx, face.outsideElemIdx);
+        ++faceRowStart_[low + 1];
+        faceNeighbor_.push_back(high);
+        trans_.push_back(face.trans);
+
+        // the first of the two thermal half transmissibilities belongs to the
+        // element with the smaller index
+        if (enableEnergy_) {
+            const bool insideIsLow = face.insideElemIdx == low;
+            thermalHalfTrans_.push_back(insideIsLow ? face.thermalHalfTransIn : face.thermalHalfTransOut);
+            thermalHalfTrans_.push_back(insideIsLow ? face.thermalHalfTransOut : face.thermalHalfTransIn);
         }
+
+        if (updateDiffusivity)
+            diffusivity_.push_back(face.diffusivity);
     }
+
+    std::partial_sum(faceRowStart_.begin(), faceRowStart_.end(), faceRowStart_.begin());
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -581,7 +672,7 @@ applyAllZMultipliers_(Scalar& trans,
                       unsigned outsideCartElemIdx,
                       const TransMult& transMult,
                       const std::array<int, dimWorld>& cartDims,
-                      bool pinchTop)
+                      bool pinchTop) const
 {
     if (insideFaceIdx > 3) { // top or or bottom
         assert(insideFaceIdx==5); // as insideCartElemIdx < outsideCartElemIdx holds for the Z column
@@ -686,22 +777,22 @@ createTransmissibilityArrays_(const std::array<bool,3>& is_tran)
             if (gc1 > gc2)
                 continue; // we only need to handle each connection once, thank you.
 
-            auto isID = isId(c1, c2);
+            auto faceIdx = checkedFaceIndex_(c1, c2);
 
             if (gc2 - gc1 == 1 && cartDims[0] > 1) {
                 if (is_tran[0])
                     // set simulator internal transmissibilities to values from inputTranx
-                     trans[0][c1] = trans_[isID];
+                     trans[0][c1] = trans_[faceIdx];
             }
             else if (gc2 - gc1 == cartDims[0] && cartDims[1] > 1) {
                 if (is_tran[1])
                     // set simulator internal transmissibilities to values from inputTrany
-                     trans[1][c1] = trans_[isID];
+                     trans[1][c1] = trans_[faceIdx];
             }
             else if (gc2 - gc1 == cartDims[0]*cartDims[1]) {
                 if (is_tran[2])
                     // set simulator internal transmissibilities to values from inputTranz
-                     trans[2][c1] = trans_[isID];
+                     trans[2][c1] = trans_[faceIdx];
             }
             //else.. We don't support modification of NNC at the moment.
         }
@@ -746,22 +837,22 @@ resetTransmissibilityFromArrays_(const std::array<bool,3>& is_tran,
             if (gc1 > gc2)
                 continue; // we only need to handle each connection once, thank you.
 
-            auto isID = isId(c1, c2);
+            auto faceIdx = checkedFaceIndex_(c1, c2);
 
             if (gc2 - gc1 == 1 && cartDims[0] > 1) {
                 if (is_tran[0])
                     // set simulator internal transmissibilities to values from inputTranx
-                    trans_[isID] = trans[0][c1];
+                    trans_[faceIdx] = trans[0][c1];
             }
             else if (gc2 - gc1 == cartDims[0] && cartDims[1] > 1) {
                 if (is_tran[1])
                     // set simulator internal transmissibilities to values from inputTrany
-                    trans_[isID] = trans[1][c1];
+                    trans_[faceIdx] = trans[1][c1];
             }
             else if (gc2 - gc1 == cartDims[0]*cartDims[1]) {
                 if (is_tran[2])
                     // set simulator internal transmissibilities to values from inputTranz
-                    trans_[isID] = trans[2][c1];
+                    trans_[faceIdx] = trans[2][c1];
             }
             //else.. We don't support modification of NNC at the moment.
         }
@@ -844,9 +935,9 @@ applyNncToGridTrans_(const std::vector<int>& cartesianToCompressed)
             continue;
         }
 
-        auto candidate = trans_.find(isId(low, high));
+        auto candidate = faceIndex_(low, high);
 
-        if (candidate == trans_.end())
+        if (candidate == faceNeighbor_.size())
             // This NNC is not resembled by the grid. Save it for later
             // processing with local cell values
             unprocessedNnc.push_back(nncEntry);
@@ -854,7 +945,7 @@ applyNncToGridTrans_(const std::vector<int>& cartesianToCompressed)
             // NNC is represented by the grid and might be a neighboring connection
             // In this case the transmissibilty is added to the value already
             // set or computed.
-            candidate->second += nncEntry.trans;
+            trans_[candidate] += nncEntry.trans;
             processedNnc.push_back(nncEntry);
         }
     }
@@ -900,8 +991,8 @@ applyEditNncToGridTrans_(const std::vector<int>& globalToLocal)
         if (low > high)
             std::swap(low, high);
 
-        auto candidate = trans_.find(isId(low, high));
-        if (candidate == trans_.end()) {
+        auto candidate = faceIndex_(low, high);
+        if (candidate == faceNeighbor_.size()) {
             const auto& location = nnc_input.edit_location( *nnc );
             auto warning = make_warning(location, *nnc);
             OpmLog::warning("EDITNNC", warning);
@@ -911,7 +1002,7 @@ applyEditNncToGridTrans_(const std::vector<int>& globalToLocal)
         else {
             // NNC exists
             while (nnc!= end && c1==nnc->cell1 && c2==nnc->cell2) {
-                candidate->second *= nnc->trans;
+                trans_[candidate] *= nnc->trans;
                 ++nnc;
             }
         }
@@ -29,15 +29,16 @@
 #define EWOMS_ECL_TRANSMISSIBILITY_HH
 
 #include <opm/grid/common/CartesianIndexMapper.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
 #include <array>
+#include <cstddef>
 #include <map>
 #include <tuple>
 #include <vector>
-#include <unordered_map>
 
 namespace Opm {
 
@@ -101,6 +102,37 @@ public:
      */
     Scalar diffusivity(unsigned elemIdx1, unsigned elemIdx2) const;
 
+    /*!
+     * \brief Return the index of the intersection between two elements in the face
+     *        indexed storage.
+     *
+     * The index stays valid as long as the grid does not change and can be used with
+     * the face variants of the accessors to avoid searching for the face again.
+     */
+    std::size_t faceIndex(unsigned elemIdx1, unsigned elemIdx2) const
+    { return checkedFaceIndex_(elemIdx1, elemIdx2); }
+
+    /*!
+     * \brief Return the transmissibility of a face given by faceIndex().
+     */
+    Scalar transmissibilityFace(std::size_t faceIdx) const
+    { return trans_[faceIdx]; }
+
+    /*!
+     * \brief Return the thermal "half transmissibility" of a face given by faceIndex().
+     *
+     * \param insideIsLower Whether the inside element has the smaller index of the
+     *                      two elements of the face.
+     */
+    Scalar thermalHalfTransFace(std::size_t faceIdx, bool insideIsLower) const
+    { return thermalHalfTrans_[2*faceIdx + (insideIsLower ? 0 : 1)]; }
+
+    /*!
+     * \brief Return the diffusivity of a face given by faceIndex().
+     */
+    Scalar diffusivityFace(std::size_t faceIdx) const
+    { return diffusivity_.empty() ? 0.0 : diffusivity_[faceIdx]; }
+
     /*!
      * \brief Actually compute the transmissibility over a face as a pre-compute step.
      *
@@ -127,6 +159,38 @@ public:
     void update(bool global);
 
 protected:
+    /// \brief Transmissibility related quantities of a face gathered during the
+    ///        traversal of the grid in update().
+    struct FaceTrans
+    {
+        unsigned insideElemIdx;
+        unsigned outsideElemIdx;
+        unsigned insideCartElemIdx;
+        unsigned outsideCartElemIdx;
+        int insideFaceIdx;
+        int outsideFaceIdx;
+        FaceDir::DirEnum faceDir;
+        Scalar trans;
+        Scalar thermalHalfTransIn;
+        Scalar thermalHalfTransOut;
+        Scalar diffusivity;
+    };
+
+    /// \brief Set up the face indexed storage from the faces found in update().
+    void buildFaceStorage_(const std::vector<FaceTrans>& faceTrans,
+                           unsigned numElements,
+                           bool updateDiffusivity);
+
+    /// \brief Index of the face between two elements in the face indexed arrays.
+    ///
+    /// \return The number of faces if the elements do not share a face.
+    std::size_t faceIndex_(unsigned elemIdx1, unsigned elemIdx2) const;
+
+    /// \brief Index of the face between two elements in the face indexed arrays.
+    ///
+    /// Throws std::out_of_range if the elements do not share a face.
+    std::size_t checkedFaceIndex_(unsigned elemIdx1, unsigned elemIdx2) const;
+
     void updateFromEclState_(bool global);
 
     void removeSmallNonCartesianTransmissibilities_();
@@ -141,7 +205,7 @@ protected:
                                unsigned outsideCartElemIdx,
                                const TransMult& transMult,
                                const std::array<int, dimWorld>& cartDims,
-                               bool pinchTop);
+                               bool pinchTop) const;
 
     /// \brief Creates TRANS{XYZ} arrays for modification by FieldProps data
     ///
@@ -231,7 +295,12 @@ protected:
 
     std::vector<DimMatrix> permeability_;
     std::vector<Scalar> porosity_;
-    std::unordered_map<std::uint64_t, Scalar> trans_;
+    // The faces between elements are stored in compressed sparse row format: for
+    // each element the faces shared with elements of larger index are stored
+    // consecutively and sorted by the index of the neighbor.
+    std::vector<unsigned> faceRowStart_;
+    std::vector<unsigned> faceNeighbor_;
+    std::vector<Scalar> trans_;
     const EclipseState& eclState_;
     const GridView& gridView_;
     const Dune::CartesianIndexMapper<Grid>& cartMapper_;
@@ -242,8 +311,9 @@ protected:
     std::map<std::pair<unsigned, unsigned>, Scalar> thermalHalfTransBoundary_;
     bool enableEnergy_;
     bool enableDiffusivity_;
-    std::unordered_map<std::uint64_t, Scalar> thermalHalfTrans_;
-    std::unordered_map<std::uint64_t, Scalar> diffusivity_;
+    // two values per face, the first one belongs to the element with the smaller index
+    std::vector<Scalar> thermalHalfTrans_;
+    std::vector<Scalar> diffusivity_;
 };
 
 } // namespace Opm
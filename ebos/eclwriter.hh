@@ -53,6 +53,18 @@ template<class TypeTag, class MyTypeTag>
 struct EclOutputDoublePrecision {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EclOutputMaxPendingWrites {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EclOutputMaxPendingMemory {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EclOutputCellDataPerRank {
+    using type = UndefinedProperty;
+};
 
 } // namespace Opm::Properties
 
@@ -107,6 +119,12 @@ public:
 
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableAsyncEclOutput,
                              "Write the ECL-formated results in a non-blocking way (i.e., using a separate thread).");
+        EWOMS_REGISTER_PARAM(TypeTag, int, EclOutputMaxPendingWrites,
+                             "Maximum number of report steps which may be queued for non-blocking ECL output before the simulation waits for the writes to complete.");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, EclOutputMaxPendingMemory,
+                             "Maximum size in MB of the cell data queued for non-blocking ECL output. Zero means no limit.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EclOutputCellDataPerRank,
+                             "Let each process write the cell data of its cells to a file of its own instead of gathering it for the restart file in parallel runs.");
     }
 
     // The Simulator object should preferably have been const - the
@@ -123,7 +141,10 @@ public:
                    simulator.vanguard().cartesianIndexMapper(),
                    simulator.vanguard().grid().comm().rank() == 0 ? &simulator.vanguard().equilCartesianIndexMapper() : nullptr,
                    simulator.vanguard().grid().comm().size() > 1 ? simulator.vanguard().globalTransmissibility() : problem.eclTransmissibilities(),
-                   EWOMS_GET_PARAM(TypeTag, bool, EnableAsyncEclOutput))
+                   EWOMS_GET_PARAM(TypeTag, bool, EnableAsyncEclOutput),
+                   EWOMS_GET_PARAM(TypeTag, int, EclOutputMaxPendingWrites),
+                   EWOMS_GET_PARAM(TypeTag, Scalar, EclOutputMaxPendingMemory),
+                   EWOMS_GET_PARAM(TypeTag, bool, EclOutputCellDataPerRank))
         , simulator_(simulator)
     {
         this->eclOutputModule_ = std::make_unique<EclOutputBlackOilModule<TypeTag>>(simulator, this->wbp_index_list_, this->collectToIORank_);
@@ -242,7 +263,15 @@ public:
             this->eclOutputModule_->addRftDataToWells(localWellData, reportStepNum);
         }
 
+        const bool doublePrecision = EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision);
         if (this->collectToIORank_.isParallel()) {
+            if (this->outputCellDataPerRank_) {
+                // every process writes the cell data of its own cells, so
+                // only the remaining data is gathered on the I/O rank
+                if (! isSubStep)
+                    this->writeLocalCellData(reportStepNum, std::move(localCellData), doublePrecision);
+                localCellData = {};
+            }
             this->collectToIORank_.collect(localCellData,
                                            eclOutputModule_->getBlockData(),
                                            eclOutputModule_->getWBPData(),
@@ -263,7 +292,7 @@ public:
                                 this->summaryState(),
                                 simulator_.problem().thresholdPressure().data(),
                                 curTime, nextStepSize,
-                                EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision));
+                                doublePrecision);
         }
     }
 
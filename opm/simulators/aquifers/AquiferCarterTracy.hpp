@@ -26,8 +26,10 @@
 #include <opm/output/data/Aquifer.hpp>
 
 #include <exception>
+#include <limits>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 
 namespace Opm
@@ -69,6 +71,29 @@ public:
         comm.sum(&this->fluxValue_, 1);
     }
 
+    // The influence function values only depend on the time step. They are
+    // evaluated here, before the (possibly threaded) linearization, so that
+    // they are not written while the connections are being assembled.
+    void beginIteration()
+    {
+        const auto& simulator = this->ebos_simulator_;
+        if (simulator.time() == this->influenceTime_ &&
+            simulator.timeStepSize() == this->influenceTimeStepSize_)
+            return;
+
+        this->dimensionless_time_ = simulator.time() / this->Tc_;
+        const Scalar td_plus_dt = (simulator.timeStepSize() + simulator.time()) / this->Tc_;
+        const auto [PItd0, PItd, PItdprime] =
+            this->getInfluenceTableValues(this->dimensionless_time_, td_plus_dt);
+
+        this->dimensionless_pressure_ = PItd0;
+        this->PItdprime_ = PItdprime;
+        this->denom_ = this->Tc_ * (PItd - this->dimensionless_time_*PItdprime);
+
+        this->influenceTime_ = simulator.time();
+        this->influenceTimeStepSize_ = simulator.timeStepSize();
+    }
+
     data::AquiferData aquiferData() const
     {
         data::AquiferData data;
@@ -101,20 +126,28 @@ protected:
     Scalar dimensionless_time_{0};
     Scalar dimensionless_pressure_{0};
 
+    // the influence function values of the time step given by influenceTime_
+    // and influenceTimeStepSize_, shared by all connections and updated in
+    // beginIteration()
+    Scalar influenceTime_{std::numeric_limits<Scalar>::quiet_NaN()};
+    Scalar influenceTimeStepSize_{std::numeric_limits<Scalar>::quiet_NaN()};
+    Scalar PItdprime_{0};
+    Scalar denom_{0};
+
     void assignRestartData(const data::AquiferData& /* xaq */) override
     {
         throw std::runtime_error {"Restart-based initialization not currently supported "
                                   "for Carter-Tracey analytic aquifers"};
     }
 
-    std::pair<Scalar, Scalar>
-    getInfluenceTableValues(const Scalar td_plus_dt)
+    // the dimensionless pressure at td and the influence table values at td + dt
+    std::tuple<Scalar, Scalar, Scalar>
+    getInfluenceTableValues(const Scalar td, const Scalar td_plus_dt) const
     {
         // We use the opm-common numeric linear interpolator
-        this->dimensionless_pressure_ =
+        const auto PItd0 =
             linearInterpolation(this->aquct_data_.td,
-                                this->aquct_data_.pi,
-                                this->dimensionless_time_);
+                                this->aquct_data_.pi, td);
 
         const auto PItd =
             linearInterpolation(this->aquct_data_.td,
@@ -124,7 +157,7 @@ protected:
             linearInterpolationDerivative(this->aquct_data_.td,
                                           this->aquct_data_.pi, td_plus_dt);
 
-        return std::make_pair(PItd, PItdprime);
+        return std::make_tuple(PItd0, PItd, PItdprime);
     }
 
     Scalar dpai(const int idx) const
@@ -135,16 +168,31 @@ protected:
         return dp;
     }
 
-    // This function implements Eqs 5.8 and 5.9 of the EclipseTechnicalDescription
-    std::pair<Scalar, Scalar>
-    calculateEqnConstants(const int idx, const Simulator& simulator)
+    // the derivative of the influence function and the denominator of Eqs 5.8
+    // and 5.9 for the time step of the simulator
+    std::pair<Scalar, Scalar> influenceValues(const Simulator& simulator) const
     {
+        if (simulator.time() == this->influenceTime_ &&
+            simulator.timeStepSize() == this->influenceTimeStepSize_)
+            return std::make_pair(this->PItdprime_, this->denom_);
+
+        // not expected during the linearization since the values are updated
+        // before each iteration, but evaluate them without touching the
+        // shared state in case the time step was changed in between
+        const Scalar td = simulator.time() / this->Tc_;
         const Scalar td_plus_dt = (simulator.timeStepSize() + simulator.time()) / this->Tc_;
-        this->dimensionless_time_ = simulator.time() / this->Tc_;
+        [[maybe_unused]] const auto [PItd0, PItd, PItdprime] =
+            this->getInfluenceTableValues(td, td_plus_dt);
 
-        const auto [PItd, PItdprime] = this->getInfluenceTableValues(td_plus_dt);
+        return std::make_pair(PItdprime, this->Tc_ * (PItd - td*PItdprime));
+    }
+
+    // This function implements Eqs 5.8 and 5.9 of the EclipseTechnicalDescription
+    std::pair<Scalar, Scalar>
+    calculateEqnConstants(const int idx, const Simulator& simulator) const
+    {
+        const auto [PItdprime, denom] = this->influenceValues(simulator);
 
-        const auto denom = this->Tc_ * (PItd - this->dimensionless_time_*PItdprime);
         const auto a = (this->beta_*dpai(idx) - this->fluxValue_*PItdprime) / denom;
         const auto b = this->beta_ / denom;
 
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -111,23 +112,10 @@ public:
 
     void beginTimeStep()
     {
-        ElementContext elemCtx(ebos_simulator_);
-        auto elemIt = ebos_simulator_.gridView().template begin<0>();
-        const auto& elemEndIt = ebos_simulator_.gridView().template end<0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-
-            const int cellIdx = elemCtx.globalSpaceIndex(0, 0);
-            const int idx = cellToConnectionIdx_[cellIdx];
-            if (idx < 0)
-                continue;
-
-            elemCtx.updateIntensiveQuantities(0);
-            const auto& iq = elemCtx.intensiveQuantities(0, 0);
+        this->forEachConnectedCell_([this](const int idx, const IntensiveQuantities& iq)
+        {
             pressure_previous_[idx] = getValue(iq.fluidState().pressure(waterPhaseIdx));
-        }
+        });
     }
 
     template <class Context>
@@ -207,6 +195,40 @@ protected:
     }
 
 
+    // call fn(connectionIdx, intQuants) for all connections of this process.
+    // the intensive quantities are taken from the cache of the model if it
+    // is up to date, so the grid is only traversed as a fallback.
+    template <class Fn>
+    void forEachConnectedCell_(Fn&& fn) const
+    {
+        const auto& model = this->ebos_simulator_.model();
+        const bool cached = std::all_of(this->connectedCells_.begin(), this->connectedCells_.end(),
+                                        [&model](const auto& cell)
+                                        { return model.cachedIntensiveQuantities(cell.first, /*timeIdx=*/0) != nullptr; });
+        if (cached) {
+            for (const auto& [cellIdx, idx] : this->connectedCells_)
+                fn(idx, *model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0));
+            return;
+        }
+
+        ElementContext elemCtx(this->ebos_simulator_);
+        const auto& gridView = this->ebos_simulator_.gridView();
+        auto elemIt = gridView.template begin</*codim=*/0>();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const auto& elem = *elemIt;
+            elemCtx.updatePrimaryStencil(elem);
+
+            const auto cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            const auto idx = this->cellToConnectionIdx_[cellIdx];
+            if (idx < 0)
+                continue;
+
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            fn(idx, elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0));
+        }
+    }
+
     virtual void endTimeStep() = 0;
 
     const int aquiferID_{};
@@ -216,6 +238,8 @@ protected:
     // Grid variables
     std::vector<Scalar> faceArea_connected_;
     std::vector<int> cellToConnectionIdx_;
+    // (cell index, connection index) of the connections of this process
+    std::vector<std::pair<int, int>> connectedCells_;
 
     // Quantities at each grid id
     std::vector<Scalar> cell_depth_;
@@ -248,18 +272,15 @@ protected:
         for (size_t idx = 0; idx < this->size(); ++idx) {
             const auto global_index = this->connections_[idx].global_index;
             const int cell_index = this->ebos_simulator_.vanguard().compressedIndex(global_index);
-            auto elemIt = gridView.template begin</*codim=*/ 0>();
-            if (cell_index > 0)
-                std::advance(elemIt, cell_index);
 
-           //the global_index is not part of this grid
-            if ( cell_index < 0 || elemIt->partitionType() != Dune::InteriorEntity)
+            //the global_index is not part of this grid
+            if ( cell_index < 0 )
                 continue;
 
             this->cellToConnectionIdx_[cell_index] = idx;
-            this->cell_depth_.at(idx) = this->ebos_simulator_.vanguard().cellCenterDepth(cell_index);
         }
         // get areas for all connections
+        this->connectedCells_.clear();
         ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
         auto elemIt = gridView.template begin</*codim=*/ 0>();
         const auto& elemEndIt = gridView.template end</*codim=*/ 0>();
@@ -272,6 +293,15 @@ protected:
             if( idx < 0)
                 continue;
 
+            // only the interior cells are handled by this process
+            if (elem.partitionType() != Dune::InteriorEntity) {
+                this->cellToConnectionIdx_[cell_index] = -1;
+                continue;
+            }
+
+            this->connectedCells_.emplace_back(cell_index, idx);
+            this->cell_depth_.at(idx) = this->ebos_simulator_.vanguard().cellCenterDepth(cell_index);
+
             auto isIt = gridView.ibegin(elem);
             const auto& isEndIt = gridView.iend(elem);
             for (; isIt != isEndIt; ++ isIt) {
@@ -344,21 +374,8 @@ protected:
         std::vector<Scalar> pw_aquifer;
         Scalar water_pressure_reservoir;
 
-        ElementContext elemCtx(this->ebos_simulator_);
-        const auto& gridView = this->ebos_simulator_.gridView();
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            elemCtx.updatePrimaryStencil(elem);
-
-            const auto cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto idx = this->cellToConnectionIdx_[cellIdx];
-            if (idx < 0)
-                continue;
-
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            const auto& iq0 = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+        this->forEachConnectedCell_([&](const int idx, const IntensiveQuantities& iq0)
+        {
             const auto& fs = iq0.fluidState();
 
             water_pressure_reservoir = fs.pressure(waterPhaseIdx).value();
@@ -367,7 +384,7 @@ protected:
                 (water_pressure_reservoir
                  - this->rhow_[idx].value() * this->gravity_() * (this->cell_depth_[idx] - this->aquiferDepth()))
                 * this->alphai_[idx]);
-        }
+        });
 
         // We take the average of the calculated equilibrium pressures.
         const auto& comm = ebos_simulator_.vanguard().grid().comm();
@@ -24,6 +24,9 @@
 #include <opm/output/data/Aquifer.hpp>
 #include <opm/parser/eclipse/EclipseState/Aquifer/NumericalAquifer/SingleNumericalAquifer.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace Opm
 {
 template <typename TypeTag>
@@ -36,6 +39,7 @@ public:
     using BlackoilIndices = GetPropType<TypeTag, Properties::Indices>;
 
     using GridView = GetPropType<TypeTag, Properties::GridView>;
+    using IntensiveQuantities = GetPropType<TypeTag, Properties::IntensiveQuantities>;
     using MaterialLaw = GetPropType<TypeTag, Properties::MaterialLaw>;
 
     enum { dimWorld = GridView::dimensionworld };
@@ -70,6 +74,22 @@ public:
                 this->cell_to_aquifer_cell_idx_[cell_idx] = idx;
             }
         }
+
+        // keep the interior aquifer cells of this process in a compact list
+        const auto& gridView = this->ebos_simulator_.gridView();
+        Dune::MultipleCodimMultipleGeomTypeMapper<GridView> elemMapper(gridView, Dune::mcmgElementLayout());
+        for (const auto& elem : elements(gridView)) {
+            if (elem.partitionType() != Dune::InteriorEntity) {
+                continue;
+            }
+            const int cell_idx = elemMapper.index(elem);
+            const int idx = this->cell_to_aquifer_cell_idx_[cell_idx];
+            if (idx < 0)
+                continue;
+            this->aquifer_cells_.push_back(cell_idx);
+            if (idx == 0)
+                this->first_cell_is_local_ = true;
+        }
     }
 
     void initFromRestart([[maybe_unused]]const std::vector<data::AquiferData>& aquiferSoln)
@@ -120,31 +140,18 @@ private:
 
     // TODO: maybe unordered_map can also do the work to save memory?
     std::vector<int> cell_to_aquifer_cell_idx_;
+    // the aquifer cells which are interior cells of this process
+    std::vector<int> aquifer_cells_;
+    // whether the first aquifer cell is an interior cell of this process
+    bool first_cell_is_local_ = false;
 
     double calculateAquiferPressure() const
     {
         double sum_pressure_watervolume = 0.;
         double sum_watervolume = 0.;
 
-        ElementContext  elem_ctx(this->ebos_simulator_);
-        const auto& gridView = this->ebos_simulator_.gridView();
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            if (elem.partitionType() != Dune::InteriorEntity) {
-                continue;
-            }
-            elem_ctx.updatePrimaryStencil(elem);
-
-            const size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
-            if (idx < 0) {
-                continue;
-            }
-
-            elem_ctx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            const auto& iq0 = elem_ctx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+        auto addCell = [&](const IntensiveQuantities& iq0, const double volume)
+        {
             const auto& fs = iq0.fluidState();
 
             // TODO: the porosity of the cells are still wrong for numerical aquifer cells
@@ -152,12 +159,43 @@ private:
             // The pore volume is correct. Extra efforts will be done to get sensible porosity value here later.
             const double water_saturation = fs.saturation(waterPhaseIdx).value();
             const double porosity = iq0.porosity().value();
-            const double volume = elem_ctx.dofTotalVolume(0, 0);
             // TODO: not sure we should use water pressure here
             const double water_pressure_reservoir = fs.pressure(waterPhaseIdx).value();
             const double water_volume = volume * porosity * water_saturation;
             sum_pressure_watervolume += water_volume * water_pressure_reservoir;
             sum_watervolume += water_volume;
+        };
+
+        // use the cached intensive quantities of the aquifer cells if they
+        // are up to date, otherwise compute them on the grid
+        const auto& model = this->ebos_simulator_.model();
+        const bool cached = std::all_of(this->aquifer_cells_.begin(), this->aquifer_cells_.end(),
+                                        [&model](const int cell_index)
+                                        { return model.cachedIntensiveQuantities(cell_index, /*timeIdx=*/0) != nullptr; });
+        if (cached) {
+            for (const int cell_index : this->aquifer_cells_)
+                addCell(*model.cachedIntensiveQuantities(cell_index, /*timeIdx=*/0),
+                        model.dofTotalVolume(cell_index));
+        }
+        else {
+            ElementContext  elem_ctx(this->ebos_simulator_);
+            const auto& gridView = this->ebos_simulator_.gridView();
+            for (const auto& elem : elements(gridView)) {
+                if (elem.partitionType() != Dune::InteriorEntity) {
+                    continue;
+                }
+                elem_ctx.updatePrimaryStencil(elem);
+
+                const size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
+                if (idx < 0) {
+                    continue;
+                }
+
+                elem_ctx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                addCell(elem_ctx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0),
+                        elem_ctx.dofTotalVolume(0, 0));
+            }
         }
 
         const auto& comm = this->ebos_simulator_.vanguard().grid().comm();
@@ -170,8 +208,14 @@ private:
     {
         double aquifer_flux = 0.;
 
+        // we only need the first aquifer cell
+        if (!this->first_cell_is_local_) {
+            return aquifer_flux;
+        }
+
         ElementContext  elem_ctx(this->ebos_simulator_);
         const auto& gridView = this->ebos_simulator_.gridView();
+        const auto& elemMapper = this->ebos_simulator_.model().elementMapper();
         auto elemIt = gridView.template begin</*codim=*/0>();
         const auto& elemEndIt = gridView.template end</*codim=*/0>();
         for (; elemIt != elemEndIt; ++elemIt) {
@@ -179,15 +223,15 @@ private:
             if (elem.partitionType() != Dune::InteriorEntity) {
                 continue;
             }
-            // elem_ctx.updatePrimaryStencil(elem);
-            elem_ctx.updateStencil(elem);
 
-            const size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            // check the cell before setting up its stencil
+            const size_t cell_index = elemMapper.index(elem);
             const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
-            // we only need the first aquifer cell
             if (idx != 0) {
                 continue;
             }
+            // elem_ctx.updatePrimaryStencil(elem);
+            elem_ctx.updateStencil(elem);
             elem_ctx.updateAllIntensiveQuantities();
             elem_ctx.updateAllExtensiveQuantities();
 
@@ -88,6 +88,11 @@ template <typename TypeTag>
 void
 BlackoilAquiferModel<TypeTag>::beginIteration()
 {
+    if (aquiferCarterTracyActive()) {
+        for (auto& aquifer : aquifers_CarterTracy) {
+            aquifer.beginIteration();
+        }
+    }
 }
 
 template <typename TypeTag>
@@ -26,6 +26,7 @@
 
 #include <ebos/eclproblem.hh>
 #include <opm/models/utils/start.hh>
+#include <opm/models/parallel/threadmanager.hh>
 
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 
@@ -35,6 +36,7 @@
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/wells/WellConnectionAuxiliaryModule.hpp>
 #include <opm/simulators/flow/countGlobalCells.hpp>
+#include <opm/simulators/flow/LocalDomainPartitioning.hpp>
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
@@ -60,11 +62,17 @@
 #include <dune/common/timer.hh>
 #include <dune/common/unused.hh>
 
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -153,10 +161,13 @@ namespace Opm {
 
         using Simulator = GetPropType<TypeTag, Properties::Simulator>;
         using Grid = GetPropType<TypeTag, Properties::Grid>;
+        using GridView = GetPropType<TypeTag, Properties::GridView>;
+        using Element = typename GridView::template Codim<0>::Entity;
         using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
         using SparseMatrixAdapter = GetPropType<TypeTag, Properties::SparseMatrixAdapter>;
         using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
         using PrimaryVariables = GetPropType<TypeTag, Properties::PrimaryVariables>;
+        using IntensiveQuantities = GetPropType<TypeTag, Properties::IntensiveQuantities>;
         using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
         using Indices = GetPropType<TypeTag, Properties::Indices>;
         using MaterialLaw = GetPropType<TypeTag, Properties::MaterialLaw>;
@@ -232,9 +243,12 @@ namespace Opm {
             perfTimer.start();
             // update the solution variables in ebos
             if ( timer.lastStepFailed() ) {
-                ebosSimulator_.model().updateFailed();
+                if (!restoreStepCheckpoint_())
+                    ebosSimulator_.model().updateFailed();
             } else {
+                storePredictorState_();
                 ebosSimulator_.model().advanceTimeLevel();
+                stepCheckpointValid_ = false;
             }
 
             // Set the timestep size, episode index, and non-linear iteration index
@@ -247,6 +261,18 @@ namespace Opm {
 
             ebosSimulator_.problem().beginTimeStep();
 
+            if (!stepCheckpointValid_)
+                saveStepCheckpoint_();
+
+            // extrapolate the initial guess from the previous time steps. a
+            // step which is restarted after a failure starts from the
+            // solution of the last converged step instead.
+            predictorApplied_ = false;
+            if (!timer.lastStepFailed())
+                applyPredictor_(timer.currentStepLength());
+            if (predictorApplied_)
+                predictorWGState_ = wellModel().activeWGState();
+
             unsigned numDof = ebosSimulator_.model().numGridDof();
             wasSwitched_.resize(numDof);
             std::fill(wasSwitched_.begin(), wasSwitched_.end(), false);
@@ -290,6 +316,15 @@ namespace Opm {
                 convergence_reports_.back().report.reserve(11);
             }
 
+            // solve the nonlinear problems of the subdomains before the
+            // global update. this needs the well rates of a previous global
+            // linearization.
+            if (param_.num_local_domains_ > 0 && iteration > 0) {
+                report += solveLocalDomains_(timer);
+                perfTimer.reset();
+                perfTimer.start();
+            }
+
             report.total_linearizations = 1;
 
             try {
@@ -309,6 +344,24 @@ namespace Opm {
             // the step is not considered converged until at least minIter iterations is done
             {
                 auto convrep = getConvergence(timer, iteration,residual_norms);
+                if (iteration == 0 && predictorApplied_) {
+                    predictorApplied_ = false;
+                    if (predictorIncreasesResidual_(convrep, residual_norms, timer.currentStepLength())) {
+                        // start the time step from the last converged
+                        // solution and linearize again.
+                        report.update_time += perfTimer.stop();
+                        revertPredictor_();
+                        convergence_reports_.pop_back();
+                        auto retryReport = nonlinearIteration(iteration, timer, nonlinear_solver);
+                        retryReport += report;
+                        return retryReport;
+                    }
+                }
+                if (iteration == 0 && !residual_norms.empty()) {
+                    predictorReferenceResidual_ = *std::max_element(residual_norms.begin(), residual_norms.end());
+                    predictorReferenceStepSize_ = timer.currentStepLength();
+                }
+
                 report.converged = convrep.converged()  && iteration > nonlinear_solver.minIter();;
                 ConvergenceReport::Severity severity = convrep.severityOfWorstFailure();
                 convergence_reports_.back().report.push_back(std::move(convrep));
@@ -580,44 +633,36 @@ namespace Opm {
 
             if( comm.size() > 1 )
             {
-                // global reduction
-                std::vector< Scalar > sumBuffer;
-                std::vector< Scalar > maxBuffer;
+                // the sums and the maxima are packed into one buffer which is
+                // exchanged by a single collective. the contributions of the
+                // processes are combined in the order of their ranks.
                 const int numComp = B_avg.size();
-                sumBuffer.reserve( 2*numComp + 1 ); // +1 for pvSum
-                maxBuffer.reserve( numComp );
-                for( int compIdx = 0; compIdx < numComp; ++compIdx )
+                const int bufferSize = 3*numComp + 1; // +1 for pvSum
+                std::vector< Scalar > localBuffer;
+                localBuffer.reserve( bufferSize );
+                localBuffer.insert( localBuffer.end(), B_avg.begin(), B_avg.end() );
+                localBuffer.insert( localBuffer.end(), R_sum.begin(), R_sum.end() );
+                localBuffer.insert( localBuffer.end(), maxCoeff.begin(), maxCoeff.end() );
+                localBuffer.push_back( pvSum );
+
+                std::vector< Scalar > globalBuffer( bufferSize*comm.size() );
+                comm.allgather( localBuffer.data(), bufferSize, globalBuffer.data() );
+
+                std::fill( B_avg.begin(), B_avg.end(), 0.0 );
+                std::fill( R_sum.begin(), R_sum.end(), 0.0 );
+                std::fill( maxCoeff.begin(), maxCoeff.end(), std::numeric_limits< Scalar >::lowest() );
+                pvSum = 0.0;
+                for( int rank = 0; rank < comm.size(); ++rank )
                 {
-                    sumBuffer.push_back( B_avg[ compIdx ] );
-                    sumBuffer.push_back( R_sum[ compIdx ] );
-                    maxBuffer.push_back( maxCoeff[ compIdx ] );
-                }
-
-                // Compute total pore volume
-                sumBuffer.push_back( pvSum );
-
-                // compute global sum
-                comm.sum( sumBuffer.data(), sumBuffer.size() );
-
-                // compute global max
-                comm.max( maxBuffer.data(), maxBuffer.size() );
-
-                // restore values to local variables
-                for( int compIdx = 0, buffIdx = 0; compIdx < numComp; ++compIdx, ++buffIdx )
-                {
-                    B_avg[ compIdx ]    = sumBuffer[ buffIdx ];
-                    ++buffIdx;
-
-                    R_sum[ compIdx ]       = sumBuffer[ buffIdx ];
-                }
-
-                for( int compIdx = 0; compIdx < numComp; ++compIdx )
-                {
-                    maxCoeff[ compIdx ] = maxBuffer[ compIdx ];
+                    const Scalar* rankBuffer = globalBuffer.data() + rank*bufferSize;
+                    for( int compIdx = 0; compIdx < numComp; ++compIdx )
+                    {
+                        B_avg[ compIdx ] += rankBuffer[ compIdx ];
+                        R_sum[ compIdx ] += rankBuffer[ numComp + compIdx ];
+                        maxCoeff[ compIdx ] = std::max( maxCoeff[ compIdx ], rankBuffer[ 2*numComp + compIdx ] );
+                    }
+                    pvSum += rankBuffer[ 3*numComp ];
                 }
-
-                // restore global pore volume
-                pvSum = sumBuffer.back();
             }
 
             // return global pore volume
@@ -625,34 +670,35 @@ namespace Opm {
         }
 
         // Get reservoir quantities on this process needed for convergence calculations.
-        double localConvergenceData(std::vector<Scalar>& R_sum,
-                                    std::vector<Scalar>& maxCoeff,
-                                    std::vector<Scalar>& B_avg)
+        double localConvergenceData(std::vector<Scalar>& R_sum_out,
+                                    std::vector<Scalar>& maxCoeff_out,
+                                    std::vector<Scalar>& B_avg_out)
         {
-            double pvSumLocal = 0.0;
             const auto& ebosModel = ebosSimulator_.model();
             const auto& ebosProblem = ebosSimulator_.problem();
-
             const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
-            ElementContext elemCtx(ebosSimulator_);
-            const auto& gridView = ebosSimulator().gridView();
-            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
-
-            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
-                 elemIt != elemEndIt;
-                 ++elemIt)
+            if (!convergenceCellsInitialized_)
+                setupConvergenceCells_();
+
+            // the cells are processed in chunks of fixed size whose partial
+            // results are combined in order afterwards. this makes the result
+            // independent of the number of threads.
+            constexpr int chunkSize = 1024;
+            constexpr int stride = 3*numEq + 1;
+            const int numCells = convergenceCells_.size();
+            const int numChunks = (numCells + chunkSize - 1)/chunkSize;
+            std::vector<Scalar> chunkData(numChunks*stride);
+
+            auto addCell = [&](const IntensiveQuantities& intQuants,
+                               const unsigned cell_idx,
+                               const double pvValue,
+                               Scalar* B_avg,
+                               Scalar* R_sum,
+                               Scalar* maxCoeff)
             {
-                const auto& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
                 const auto& fs = intQuants.fluidState();
 
-                const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) * ebosModel.dofTotalVolume( cell_idx );
-                pvSumLocal += pvValue;
-
                 for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx)
                 {
                     if (!FluidSystem::phaseIsActive(phaseIdx)) {
@@ -717,19 +763,71 @@ namespace Opm {
                     R_sum[ contiEnergyEqIdx ] += R2;
                     maxCoeff[ contiEnergyEqIdx ] = std::max( maxCoeff[ contiEnergyEqIdx ], std::abs( R2 ) / pvValue );
                 }
+            };
 
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                // only needed if the intensive quantities are not cached
+                std::unique_ptr<ElementContext> elemCtx;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                for (int chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+                    Scalar* B_avg = chunkData.data() + chunkIdx*stride;
+                    Scalar* R_sum = B_avg + numEq;
+                    Scalar* maxCoeff = R_sum + numEq;
+                    Scalar& pvSum = maxCoeff[numEq];
+                    std::fill(B_avg, maxCoeff, 0.0);
+                    std::fill(maxCoeff, maxCoeff + numEq, std::numeric_limits<Scalar>::lowest());
+                    pvSum = 0.0;
+
+                    const int cellEnd = std::min(numCells, (chunkIdx + 1)*chunkSize);
+                    for (int i = chunkIdx*chunkSize; i < cellEnd; ++i) {
+                        const unsigned cell_idx = convergenceCells_[i];
+                        const IntensiveQuantities* intQuants = ebosModel.cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0);
+                        if (!intQuants) {
+                            if (!elemCtx)
+                                elemCtx = std::make_unique<ElementContext>(ebosSimulator_);
+                            elemCtx->updatePrimaryStencil(convergenceElements_[i]);
+                            elemCtx->updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                            intQuants = &elemCtx->intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+                        }
+
+                        // the reference porosity may change during the run
+                        const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0)
+                            * ebosModel.dofTotalVolume(cell_idx);
+                        pvSum += pvValue;
+                        addCell(*intQuants, cell_idx, pvValue, B_avg, R_sum, maxCoeff);
+                    }
+                }
+            }
+
+            double pvSumLocal = 0.0;
+            for (int chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+                const Scalar* chunk = chunkData.data() + chunkIdx*stride;
+                for (int compIdx = 0; compIdx < numEq; ++compIdx) {
+                    B_avg_out[compIdx] += chunk[compIdx];
+                    R_sum_out[compIdx] += chunk[numEq + compIdx];
+                    maxCoeff_out[compIdx] = std::max(maxCoeff_out[compIdx], chunk[2*numEq + compIdx]);
+                }
+                pvSumLocal += chunk[3*numEq];
             }
 
             // compute local average in terms of global number of elements
-            const int bSize = B_avg.size();
+            const int bSize = B_avg_out.size();
             for ( int i = 0; i<bSize; ++i )
             {
-                B_avg[ i ] /= Scalar( global_nc_ );
+                B_avg_out[ i ] /= Scalar( global_nc_ );
             }
 
             return pvSumLocal;
         }
 
+        // Pore volume of the cells on this process which violate the CNV
+        // tolerance.
         double computeCnvErrorPv(const std::vector<Scalar>& B_avg, double dt)
         {
             double errorPV{};
@@ -761,27 +859,22 @@ namespace Opm {
                 }
             }
 
-            return grid_.comm().sum(errorPV);
+            return errorPV;
         }
 
+        /// \param[in]  pvSum                total pore volume
+        /// \param[in]  cnvErrorPvFraction   fraction of the pore volume violating the CNV tolerance
+        /// \param[in]  R_sum, maxCoeff, B_avg  globally reduced residual sums, maxima and averages
         ConvergenceReport getReservoirConvergence(const double dt,
                                                   const int iteration,
-                                                  std::vector<Scalar>& B_avg,
+                                                  const double pvSum,
+                                                  const double cnvErrorPvFraction,
+                                                  const std::vector<Scalar>& R_sum,
+                                                  const std::vector<Scalar>& maxCoeff,
+                                                  const std::vector<Scalar>& B_avg,
                                                   std::vector<Scalar>& residual_norms)
         {
-            typedef std::vector< Scalar > Vector;
-
             const int numComp = numEq;
-            Vector R_sum(numComp, 0.0 );
-            Vector maxCoeff(numComp, std::numeric_limits< Scalar >::lowest() );
-            const double pvSumLocal = localConvergenceData(R_sum, maxCoeff, B_avg);
-
-            // compute global sum and max of quantities
-            const double pvSum = convergenceReduction(grid_.comm(), pvSumLocal,
-                                                      R_sum, maxCoeff, B_avg);
-
-            auto cnvErrorPvFraction = computeCnvErrorPv(B_avg, dt);
-            cnvErrorPvFraction /= pvSum;
 
             const double tol_mb  = param_.tolerance_mb_;
             // Default value of relaxed_max_pv_fraction_ is 1 and
@@ -912,10 +1005,40 @@ namespace Opm {
                                          const int iteration,
                                          std::vector<double>& residual_norms)
         {
-            // Get convergence reports for reservoir and wells.
+            const double dt = timer.currentStepLength();
+
+            // compute global sum and max of the reservoir quantities
             std::vector<Scalar> B_avg(numEq, 0.0);
-            auto report = getReservoirConvergence(timer.currentStepLength(), iteration, B_avg, residual_norms);
-            report += wellModel().getWellConvergence(B_avg);
+            std::vector<Scalar> R_sum(numEq, 0.0);
+            std::vector<Scalar> maxCoeff(numEq, std::numeric_limits< Scalar >::lowest());
+            const double pvSumLocal = localConvergenceData(R_sum, maxCoeff, B_avg);
+            const double pvSum = convergenceReduction(grid_.comm(), pvSumLocal,
+                                                      R_sum, maxCoeff, B_avg);
+
+            // everything which depends on the global averages is reduced
+            // together: the pore volume violating the CNV tolerance, the
+            // number of well failures and the number of well messages. the
+            // details of the wells are only gathered if there is something
+            // to report.
+            DeferredLogger local_deferredLogger;
+            const ConvergenceReport localWellReport =
+                wellModel().getLocalWellConvergence(B_avg, local_deferredLogger);
+            double sumBuffer[3] = { computeCnvErrorPv(B_avg, dt),
+                                    static_cast<double>(localWellReport.wellFailures().size()),
+                                    static_cast<double>(local_deferredLogger.numMessages()) };
+            if (grid_.comm().size() > 1)
+                grid_.comm().sum(sumBuffer, 3);
+
+            // Get convergence reports for reservoir and wells.
+            auto report = getReservoirConvergence(dt, iteration, pvSum, sumBuffer[0]/pvSum,
+                                                  R_sum, maxCoeff, B_avg, residual_norms);
+            report += wellModel().gatherWellConvergence(localWellReport, local_deferredLogger,
+                                                        /*anyWellFailed=*/sumBuffer[1] > 0,
+                                                        /*anyMessages=*/sumBuffer[2] > 0);
+
+            // the subdomains measure their residuals with the global averages
+            if (param_.num_local_domains_ > 0)
+                localDomainBAvg_ = B_avg;
 
             return report;
         }
@@ -1022,6 +1145,491 @@ namespace Opm {
         double drMaxRel() const { return param_.dr_max_rel_; }
         double maxResidualAllowed() const { return param_.max_residual_allowed_; }
         double linear_solve_setup_time_;
+
+        /// \brief The intensive quantities at the start of the current time step
+        std::vector<IntensiveQuantities> stepCheckpoint_;
+        bool stepCheckpointValid_ = false;
+
+        // store the intensive quantities of the start of the time step. this
+        // is only possible if all of them are cached by the model.
+        void saveStepCheckpoint_()
+        {
+            if (!param_.use_time_step_checkpoint_)
+                return;
+
+            const auto& model = ebosSimulator_.model();
+            const unsigned numDof = model.numGridDof();
+            stepCheckpoint_.resize(numDof);
+            for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+                const auto* intQuants = model.cachedIntensiveQuantities(dofIdx, /*timeIdx=*/0);
+                if (!intQuants)
+                    return;
+                stepCheckpoint_[dofIdx] = *intQuants;
+            }
+            stepCheckpointValid_ = true;
+        }
+
+        // reset the solution to the start of the time step after a failed
+        // step. the intensive quantities are copied back from the checkpoint
+        // instead of being recomputed from the primary variables.
+        bool restoreStepCheckpoint_()
+        {
+            if (!stepCheckpointValid_)
+                return false;
+
+            auto& model = ebosSimulator_.model();
+            model.solution(/*timeIdx=*/0) = model.solution(/*timeIdx=*/1);
+
+            const unsigned numDof = stepCheckpoint_.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx)
+                model.updateCachedIntensiveQuantities(stepCheckpoint_[dofIdx], dofIdx, /*timeIdx=*/0);
+
+            return true;
+        }
+
+        /// \brief The converged solutions of the previous time steps and
+        ///        the sizes of the time steps which started from them, most
+        ///        recent first
+        std::vector<std::pair<SolutionVector, double>> predictorHistory_;
+        // the extrapolation is at most quadratic
+        static constexpr std::size_t maxPredictorOrder_ = 2;
+        bool predictorApplied_ = false;
+        // the largest CNV residual of the first linearization of the last
+        // time step and the size of that step
+        double predictorReferenceResidual_ = std::numeric_limits<double>::max();
+        double predictorReferenceStepSize_ = 0.0;
+        // the well and group state before the first linearization from the
+        // predicted solution
+        WGState predictorWGState_;
+
+        // remember the solution at the beginning of the time step which just
+        // converged. must be called before the time levels are advanced.
+        void storePredictorState_()
+        {
+            const int order = param_.newton_predictor_order_;
+            const double dt = ebosSimulator_.timeStepSize();
+            if (order <= 0 || !(dt > 0.0))
+                return;
+
+            predictorHistory_.emplace(predictorHistory_.begin(),
+                                      ebosSimulator_.model().solution(/*timeIdx=*/1), dt);
+            const auto maxHist = std::min(static_cast<std::size_t>(order), maxPredictorOrder_);
+            while (predictorHistory_.size() > maxHist)
+                predictorHistory_.pop_back();
+        }
+
+        // extrapolate the last converged solutions to the end of the new time
+        // step. the difference to the current solution is applied as a
+        // regular Newton update, so it is chopped like one.
+        void applyPredictor_(const double dt)
+        {
+            if (predictorHistory_.empty() || !(dt > 0.0))
+                return;
+
+            // weights of the Lagrange polynomial through the previous
+            // solutions, i.e., x_pred = x_n + sum_k w_k*(x_k - x_n)
+            const double h1 = predictorHistory_[0].second;
+            double w1 = -dt/h1;
+            double w2 = 0.0;
+            if (predictorHistory_.size() > 1) {
+                const double h2 = predictorHistory_[1].second;
+                w1 = -dt*(dt + h1 + h2)/(h1*h2);
+                w2 = dt*(dt + h1)/((h1 + h2)*h2);
+            }
+            const double weights[maxPredictorOrder_] = { w1, w2 };
+            const std::size_t numHist = std::min(predictorHistory_.size(), maxPredictorOrder_);
+
+            const SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
+            const int numCells = solution.size();
+            BVector dx(numCells);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+                dx[cellIdx] = 0.0;
+                const auto& priVars = solution[cellIdx];
+
+                // the primary variables are not comparable if their meaning
+                // changed in between
+                bool sameMeaning = true;
+                for (std::size_t k = 0; k < numHist; ++k)
+                    sameMeaning = sameMeaning
+                        && predictorHistory_[k].first[cellIdx].primaryVarsMeaning() == priVars.primaryVarsMeaning();
+                if (!sameMeaning)
+                    continue;
+
+                for (std::size_t k = 0; k < numHist; ++k) {
+                    const auto& oldPriVars = predictorHistory_[k].first[cellIdx];
+                    for (int eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                        dx[cellIdx][eqIdx] += weights[k]*(priVars[eqIdx] - oldPriVars[eqIdx]);
+                }
+            }
+
+            updateSolution(dx);
+            predictorApplied_ = true;
+        }
+
+        // the prediction is discarded if its residual is larger than the one
+        // of the first linearization of the last time step. the CNV of an
+        // unpredicted start grows about linearly with the step size, so the
+        // reference is scaled to the new step instead of linearizing the
+        // unpredicted solution once more. the CNV values are global
+        // quantities, so all processes take the same decision.
+        bool predictorIncreasesResidual_(const ConvergenceReport& convrep,
+                                         const std::vector<double>& residual_norms,
+                                         const double dt) const
+        {
+            const auto severity = convrep.severityOfWorstFailure();
+            if (severity == ConvergenceReport::Severity::NotANumber
+                || severity == ConvergenceReport::Severity::TooLarge)
+                return true;
+
+            if (residual_norms.empty())
+                return false;
+
+            const double maxResidual = *std::max_element(residual_norms.begin(), residual_norms.end());
+            double reference = predictorReferenceResidual_;
+            if (predictorReferenceStepSize_ > 0.0)
+                reference *= dt/predictorReferenceStepSize_;
+            return !(maxResidual <= reference);
+        }
+
+        void revertPredictor_()
+        {
+            if (terminalOutputEnabled())
+                OpmLog::debug("    Predicted initial guess increases the residual, starting from the last solution");
+
+            if (!restoreStepCheckpoint_())
+                ebosSimulator_.model().updateFailed();
+            wellModel().setActiveWGState(std::move(predictorWGState_));
+        }
+
+        /// \brief A part of the interior cells of this process which is
+        ///        solved as a separate nonlinear problem
+        struct LocalDomain
+        {
+            std::vector<int> cells;
+            std::vector<Element> elements;
+            Mat jacobian;
+            int color = 0;
+        };
+
+        std::vector<LocalDomain> localDomains_;
+        // the domain of each cell and the position of the cell within the
+        // domain, -1 for cells which are not part of any domain
+        std::vector<int> cellDomain_;
+        std::vector<int> localDomainIndex_;
+        int numDomainColors_ = 0;
+        bool localDomainsInitialized_ = false;
+        std::vector<Scalar> localDomainBAvg_;
+
+        // partition the interior cells of this process into connected
+        // subdomains of about the same size.
+        void setupLocalDomains_()
+        {
+            localDomainsInitialized_ = true;
+
+            const auto& gridView = ebosSimulator_.gridView();
+            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+            const int numCells = ebosSimulator_.model().numGridDof();
+
+            // the cells at the process boundary are part of the overlap of
+            // the neighbouring processes. they are left to the global
+            // update to keep both copies consistent.
+            std::vector<std::vector<int>> neighbours(numCells);
+            std::vector<char> eligible(numCells, 0);
+            for (const auto& elem : elements(gridView)) {
+                if (elem.partitionType() != Dune::InteriorEntity)
+                    continue;
+
+                const int cellIdx = elemMapper.index(elem);
+                bool atProcessBoundary = false;
+                for (const auto& intersection : intersections(gridView, elem)) {
+                    if (!intersection.neighbor())
+                        continue;
+
+                    const auto& outside = intersection.outside();
+                    if (outside.partitionType() != Dune::InteriorEntity)
+                        atProcessBoundary = true;
+                    else
+                        neighbours[cellIdx].push_back(elemMapper.index(outside));
+                }
+                eligible[cellIdx] = !atProcessBoundary;
+            }
+
+            cellDomain_ = partitionLocalDomains(neighbours, eligible, param_.num_local_domains_);
+            const int numDomains = cellDomain_.empty()
+                ? 0 : *std::max_element(cellDomain_.begin(), cellDomain_.end()) + 1;
+            localDomainIndex_.assign(numCells, -1);
+            if (numDomains <= 0)
+                return;
+
+            localDomains_.resize(numDomains);
+            for (const auto& elem : elements(gridView)) {
+                if (elem.partitionType() != Dune::InteriorEntity)
+                    continue;
+
+                const int cellIdx = elemMapper.index(elem);
+                if (cellDomain_[cellIdx] < 0)
+                    continue;
+
+                auto& domain = localDomains_[cellDomain_[cellIdx]];
+                localDomainIndex_[cellIdx] = domain.cells.size();
+                domain.cells.push_back(cellIdx);
+                domain.elements.push_back(elem);
+            }
+
+            // the domains of one color can be solved concurrently
+            const auto colors = colorLocalDomains(neighbours, cellDomain_, numDomains);
+            numDomainColors_ = *std::max_element(colors.begin(), colors.end()) + 1;
+            for (int domainIdx = 0; domainIdx < numDomains; ++domainIdx) {
+                auto& domain = localDomains_[domainIdx];
+                domain.color = colors[domainIdx];
+
+                // the sparsity pattern of the Jacobian of the domain
+                const int domainSize = domain.cells.size();
+                domain.jacobian.setBuildMode(Mat::row_wise);
+                domain.jacobian.setSize(domainSize, domainSize);
+                for (auto row = domain.jacobian.createbegin(); row != domain.jacobian.createend(); ++row) {
+                    const int cellIdx = domain.cells[row.index()];
+                    row.insert(row.index());
+                    for (const int nbIdx : neighbours[cellIdx]) {
+                        if (cellDomain_[nbIdx] == domainIdx)
+                            row.insert(localDomainIndex_[nbIdx]);
+                    }
+                }
+            }
+
+            if (terminalOutputEnabled())
+                OpmLog::debug("Nonlinear domain decomposition: " + std::to_string(numDomains)
+                              + " subdomains in " + std::to_string(numDomainColors_) + " colors");
+        }
+
+        // solve the nonlinear problem of every subdomain with the cells
+        // outside of the domain and the wells fixed. the domains of one color
+        // are solved in parallel.
+        SimulatorReportSingle solveLocalDomains_(const SimulatorTimerInterface& timer)
+        {
+            SimulatorReportSingle report;
+            if (!localDomainsInitialized_)
+                setupLocalDomains_();
+            if (localDomains_.empty() || localDomainBAvg_.empty())
+                return report;
+
+            Dune::Timer perfTimer;
+            perfTimer.start();
+
+            const double dt = timer.currentStepLength();
+            const int numDomains = localDomains_.size();
+            int numConverged = 0;
+            int numIterations = 0;
+            int numFailed = 0;
+            for (int color = 0; color < numDomainColors_; ++color) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:numConverged,numIterations,numFailed)
+#endif
+                for (int domainIdx = 0; domainIdx < numDomains; ++domainIdx) {
+                    if (localDomains_[domainIdx].color != color)
+                        continue;
+
+                    // exceptions must not escape the parallel region. a
+                    // domain which could not even be reset leaves the
+                    // solution inconsistent, which is reported below.
+                    int iterations = 0;
+                    try {
+                        if (solveLocalDomain_(domainIdx, dt, iterations))
+                            ++numConverged;
+                    }
+                    catch (...) {
+                        ++numFailed;
+                    }
+                    numIterations += iterations;
+                }
+            }
+
+            report.update_time += perfTimer.stop();
+
+            if (numFailed > 0)
+                OPM_THROW(NumericalIssue, "Failed to reset " << numFailed << " of "
+                          << numDomains << " subdomains after their local solve failed");
+
+            if (terminalOutputEnabled())
+                OpmLog::debug("    Local solves: " + std::to_string(numConverged) + " of "
+                              + std::to_string(numDomains) + " subdomains converged, "
+                              + std::to_string(numIterations) + " local iterations");
+
+            return report;
+        }
+
+        // Newton's method for a single subdomain. the primary variables of
+        // the domain are reset if it does not converge.
+        bool solveLocalDomain_(const int domainIdx, const double dt, int& iterations)
+        {
+            auto& domain = localDomains_[domainIdx];
+            auto& model = ebosSimulator_.model();
+            const auto& problem = ebosSimulator_.problem();
+            auto& localLinearizer = model.localLinearizer(ThreadManager::threadId());
+            ElementContext elemCtx(ebosSimulator_);
+            SolutionVector& solution = model.solution(/*timeIdx=*/0);
+
+            const int domainSize = domain.cells.size();
+            std::vector<PrimaryVariables> initialPriVars(domainSize);
+            for (int i = 0; i < domainSize; ++i)
+                initialPriVars[i] = solution[domain.cells[i]];
+
+            const double tolMb = param_.tolerance_mb_*param_.local_tolerance_scaling_mb_;
+            const double tolCnv = param_.tolerance_cnv_*param_.local_tolerance_scaling_cnv_;
+
+            BVector residual(domainSize);
+            BVector dx(domainSize);
+            bool converged = false;
+            // an exception, e.g. from the linearization or the update of the
+            // intensive quantities, counts as a failure of the local solve
+            try {
+                for (iterations = 0; ; ++iterations) {
+                    // linearize the mass balances of the domain cells. only the
+                    // derivatives with respect to the domain cells are kept.
+                    residual = 0.0;
+                    domain.jacobian = 0.0;
+                    for (int i = 0; i < domainSize; ++i) {
+                        localLinearizer.linearize(elemCtx, domain.elements[i]);
+                        residual[i] = localLinearizer.residual(/*dofIdx=*/0);
+                        for (unsigned dofIdx = 0; dofIdx < elemCtx.numDof(/*timeIdx=*/0); ++dofIdx) {
+                            const unsigned globJ = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
+                            if (cellDomain_[globJ] != domainIdx)
+                                continue;
+                            domain.jacobian[localDomainIndex_[globJ]][i] += localLinearizer.jacobian(dofIdx, /*primaryDofIdx=*/0);
+                        }
+                    }
+
+                    // same measures as the global convergence check
+                    std::vector<Scalar> R_sum(numEq, 0.0);
+                    std::vector<Scalar> maxCoeff(numEq, 0.0);
+                    double pvSum = 0.0;
+                    for (int i = 0; i < domainSize; ++i) {
+                        const int cellIdx = domain.cells[i];
+                        const double pvValue = problem.referencePorosity(cellIdx, /*timeIdx=*/0) * model.dofTotalVolume(cellIdx);
+                        pvSum += pvValue;
+                        for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                            Scalar R = residual[i][eqIdx];
+                            if constexpr (has_polymermw_) {
+                                if (eqIdx == contiPolymerMWEqIdx)
+                                    R /= 100.;
+                            }
+                            R_sum[eqIdx] += R;
+                            maxCoeff[eqIdx] = std::max(maxCoeff[eqIdx], std::abs(R)/pvValue);
+                        }
+                    }
+
+                    bool finite = true;
+                    converged = true;
+                    for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                        const double cnv = localDomainBAvg_[eqIdx] * dt * maxCoeff[eqIdx];
+                        const double mb = std::abs(localDomainBAvg_[eqIdx] * R_sum[eqIdx]) * dt / pvSum;
+                        finite = finite && std::isfinite(cnv) && std::isfinite(mb);
+                        converged = converged && cnv <= tolCnv && mb <= tolMb;
+                    }
+                    if (converged || !finite || iterations >= param_.max_local_solve_iterations_)
+                        break;
+
+                    // solve the linear system of the domain
+                    bool solved = false;
+                    try {
+                        dx = 0.0;
+                        Dune::MatrixAdapter<Mat, BVector, BVector> domainOperator(domain.jacobian);
+                        Dune::SeqILU<Mat, BVector, BVector> domainPreconditioner(domain.jacobian, 0, 1.0); // results in ILU0
+                        Dune::BiCGSTABSolver<BVector> domainSolver(domainOperator, domainPreconditioner,
+                                                                   /*reduction=*/1e-3, /*maxIter=*/200,
+                                                                   /*verbose=*/0);
+                        BVector rhs(residual);
+                        Dune::InverseOperatorResult result;
+                        domainSolver.apply(dx, rhs, result);
+                        solved = result.converged;
+                    }
+                    catch (const Dune::Exception&) {
+                        solved = false;
+                    }
+                    if (!solved)
+                        break;
+
+                    // the primary variable update of the Newton method keeps
+                    // global bookkeeping, so the domains update one at a time.
+                    bool updated = true;
+#ifdef _OPENMP
+#pragma omp critical(localDomainUpdate)
+#endif
+                    {
+                        try {
+                            auto& newtonMethod = model.newtonMethod();
+                            for (int i = 0; i < domainSize; ++i) {
+                                const int cellIdx = domain.cells[i];
+                                const PrimaryVariables currentValue = solution[cellIdx];
+                                newtonMethod.updatePrimaryVariables_(cellIdx, solution[cellIdx], currentValue,
+                                                                     dx[i], residual[i]);
+                            }
+                        }
+                        catch (...) {
+                            updated = false;
+                        }
+                    }
+                    if (!updated)
+                        break;
+
+                    updateDomainIntensiveQuantities_(domain, elemCtx);
+                }
+            }
+            catch (...) {
+                converged = false;
+            }
+
+            if (!converged) {
+                for (int i = 0; i < domainSize; ++i)
+                    solution[domain.cells[i]] = initialPriVars[i];
+                updateDomainIntensiveQuantities_(domain, elemCtx);
+            }
+
+            return converged;
+        }
+
+        void updateDomainIntensiveQuantities_(const LocalDomain& domain, ElementContext& elemCtx)
+        {
+            auto& model = ebosSimulator_.model();
+            const int domainSize = domain.cells.size();
+            for (int i = 0; i < domainSize; ++i) {
+                const int cellIdx = domain.cells[i];
+                model.setIntensiveQuantitiesCacheEntryValidity(cellIdx, /*timeIdx=*/0, false);
+                elemCtx.updatePrimaryStencil(domain.elements[i]);
+                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                model.updateCachedIntensiveQuantities(elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0),
+                                                      cellIdx, /*timeIdx=*/0);
+            }
+        }
+
+        /// \brief The interior cells of this process and their elements,
+        ///        used by the convergence check
+        std::vector<unsigned> convergenceCells_;
+        std::vector<Element> convergenceElements_;
+        bool convergenceCellsInitialized_ = false;
+
+        void setupConvergenceCells_()
+        {
+            convergenceCellsInitialized_ = true;
+
+            const auto& ebosModel = ebosSimulator_.model();
+            const auto& elemMapper = ebosModel.elementMapper();
+            for (const auto& elem : elements(ebosSimulator_.gridView())) {
+                if (elem.partitionType() != Dune::InteriorEntity)
+                    continue;
+
+                const unsigned cell_idx = elemMapper.index(elem);
+                convergenceCells_.push_back(cell_idx);
+                convergenceElements_.push_back(elem);
+            }
+        }
+
     public:
         std::vector<bool> wasSwitched_;
     };
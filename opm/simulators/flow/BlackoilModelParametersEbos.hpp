@@ -23,6 +23,7 @@
 #include <opm/models/utils/propertysystem.hh>
 #include <opm/models/utils/parametersystem.hh>
 
+#include <algorithm>
 #include <string>
 
 namespace Opm::Properties {
@@ -100,6 +101,30 @@ struct UseUpdateStabilization {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct UseTimeStepCheckpoint {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NewtonPredictorOrder {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NumLocalDomains {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct MaxLocalSolveIterations {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LocalToleranceScalingMb {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LocalToleranceScalingCnv {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct MatrixAddWellContributions {
     using type = UndefinedProperty;
 };
@@ -153,6 +178,10 @@ template<class TypeTag, class MyTypeTag>
 struct AlternativeWellRateInit {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct WellPotentialUpdateTolerance {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct DbhpMaxRel<TypeTag, TTag::FlowModelParameters> {
@@ -229,6 +258,32 @@ struct UseUpdateStabilization<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = true;
 };
 template<class TypeTag>
+struct UseTimeStepCheckpoint<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct NewtonPredictorOrder<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct NumLocalDomains<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct MaxLocalSolveIterations<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 20;
+};
+template<class TypeTag>
+struct LocalToleranceScalingMb<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 1.0;
+};
+template<class TypeTag>
+struct LocalToleranceScalingCnv<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.1;
+};
+template<class TypeTag>
 struct MatrixAddWellContributions<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = false;
 };
@@ -263,6 +318,11 @@ struct AlternativeWellRateInit<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = true;
 };
 template<class TypeTag>
+struct WellPotentialUpdateTolerance<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+template<class TypeTag>
 struct StrictInnerIterMsWells<TypeTag, TTag::FlowModelParameters> {
     static constexpr int value = 40;
 };
@@ -358,6 +418,11 @@ namespace Opm
         /// Maximum iteration number of the well equation solution
         int max_welleq_iter_;
 
+        /// Maximum relative change of the connection cell pressures and
+        /// mobilities for which the well potentials of the previous time step
+        /// are reused. Zero means the potentials are always recomputed.
+        double well_potential_update_tolerance_;
+
         /// Tolerance for time step in seconds where single precision can be used
         /// for solving for the Jacobian
         double maxSinglePrecisionTimeStep_;
@@ -374,6 +439,27 @@ namespace Opm
         /// Try to detect oscillation or stagnation.
         bool use_update_stabilization_;
 
+        /// Keep a copy of the intensive quantities at the start of a time step
+        /// to restore them when the step has to be restarted.
+        bool use_time_step_checkpoint_;
+
+        /// Order of the extrapolation in time of the previously converged
+        /// solutions used as initial guess of a time step (0 disables it,
+        /// at most 2).
+        int newton_predictor_order_;
+
+        /// Number of subdomains per process for the nonlinear domain
+        /// decomposition (0 disables the local solves).
+        int num_local_domains_;
+
+        /// Maximum number of Newton iterations for a subdomain.
+        int max_local_solve_iterations_;
+
+        /// Factors applied to the mass balance and CNV tolerances when
+        /// checking the convergence of a subdomain.
+        double local_tolerance_scaling_mb_;
+        double local_tolerance_scaling_cnv_;
+
         /// Whether to use MultisegmentWell to handle multisegment wells
         /// it is something temporary before the multisegment well model is considered to be
         /// well developed and tested.
@@ -400,6 +486,7 @@ namespace Opm
             tolerance_wells_ = EWOMS_GET_PARAM(TypeTag, Scalar, ToleranceWells);
             tolerance_well_control_ = EWOMS_GET_PARAM(TypeTag, Scalar, ToleranceWellControl);
             max_welleq_iter_ = EWOMS_GET_PARAM(TypeTag, int, MaxWelleqIter);
+            well_potential_update_tolerance_ = EWOMS_GET_PARAM(TypeTag, Scalar, WellPotentialUpdateTolerance);
             use_multisegment_well_ = EWOMS_GET_PARAM(TypeTag, bool, UseMultisegmentWell);
             tolerance_pressure_ms_wells_ = EWOMS_GET_PARAM(TypeTag, Scalar, TolerancePressureMsWells);
             relaxed_inner_tolerance_flow_ms_well_ = EWOMS_GET_PARAM(TypeTag, Scalar, RelaxedFlowTolInnerIterMsw);
@@ -416,6 +503,13 @@ namespace Opm
             solve_welleq_initially_ = EWOMS_GET_PARAM(TypeTag, bool, SolveWelleqInitially);
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
+            use_time_step_checkpoint_ = EWOMS_GET_PARAM(TypeTag, bool, UseTimeStepCheckpoint);
+            // only linear and quadratic extrapolation is implemented
+            newton_predictor_order_ = std::clamp(EWOMS_GET_PARAM(TypeTag, int, NewtonPredictorOrder), 0, 2);
+            num_local_domains_ = EWOMS_GET_PARAM(TypeTag, int, NumLocalDomains);
+            max_local_solve_iterations_ = EWOMS_GET_PARAM(TypeTag, int, MaxLocalSolveIterations);
+            local_tolerance_scaling_mb_ = EWOMS_GET_PARAM(TypeTag, Scalar, LocalToleranceScalingMb);
+            local_tolerance_scaling_cnv_ = EWOMS_GET_PARAM(TypeTag, Scalar, LocalToleranceScalingCnv);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
 
             deck_file_name_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
@@ -445,12 +539,20 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseInnerIterationsWells, "Use nested iterations for standard wells");
             EWOMS_REGISTER_PARAM(TypeTag, int, MaxInnerIterWells, "Maximum number of inner iterations for standard wells");
             EWOMS_REGISTER_PARAM(TypeTag, bool, AlternativeWellRateInit, "Use alternative well rate initialization procedure");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, WellPotentialUpdateTolerance, "Maximum relative change of the pressures and mobilities in the connection cells of a well "
+                                 "for which its potentials from the previous time step are reused. Zero means that the potentials are always recomputed");
             EWOMS_REGISTER_PARAM(TypeTag, Scalar, RegularizationFactorMsw, "Regularization factor for ms wells");
             EWOMS_REGISTER_PARAM(TypeTag, Scalar, MaxSinglePrecisionDays, "Maximum time step size where single precision floating point arithmetic can be used solving for the linear systems of equations");
             EWOMS_REGISTER_PARAM(TypeTag, int, MaxStrictIter, "Maximum number of Newton iterations before relaxed tolerances are used for the CNV convergence criterion");
             EWOMS_REGISTER_PARAM(TypeTag, bool, SolveWelleqInitially, "Fully solve the well equations before each iteration of the reservoir model");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UpdateEquationsScaling, "Update scaling factors for mass balance equations during the run");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseTimeStepCheckpoint, "Restore the intensive quantities of the start of a time step from memory when the step has to be restarted. This keeps a copy of the intensive quantities of all cells");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NewtonPredictorOrder, "Order of the extrapolation in time used as the initial guess of the Newton method (0: no predictor, 1: linear, 2: quadratic)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NumLocalDomains, "Number of subdomains per process which are solved as local nonlinear problems before each global Newton update (0: disabled)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, MaxLocalSolveIterations, "Maximum number of Newton iterations for the nonlinear problem of a subdomain");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, LocalToleranceScalingMb, "Factor applied to the mass balance tolerance for the convergence of a subdomain");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, LocalToleranceScalingCnv, "Factor applied to the CNV tolerance for the convergence of a subdomain");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheck, "Enable the well operability checking");
         }
@@ -0,0 +1,111 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/flow/LocalDomainPartitioning.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Opm {
+
+std::vector<int>
+partitionLocalDomains(const std::vector<std::vector<int>>& neighbours,
+                      const std::vector<char>& eligible,
+                      const int numTargetDomains)
+{
+    const int numCells = neighbours.size();
+    std::vector<int> cellDomain(numCells, -1);
+
+    const int numEligible = std::count(eligible.begin(), eligible.end(), 1);
+    const int numDomains = std::min(numTargetDomains, numEligible);
+    if (numDomains <= 0)
+        return cellDomain;
+
+    const int targetSize = (numEligible + numDomains - 1)/numDomains;
+    int domainIdx = 0;
+    std::vector<int> queue;
+    for (int seed = 0; seed < numCells; ++seed) {
+        if (!eligible[seed] || cellDomain[seed] >= 0)
+            continue;
+
+        int domainSize = 1;
+        cellDomain[seed] = domainIdx;
+        queue.assign(1, seed);
+        for (std::size_t pos = 0; pos < queue.size() && domainSize < targetSize; ++pos) {
+            for (const int nbIdx : neighbours[queue[pos]]) {
+                if (domainSize == targetSize)
+                    break;
+                if (!eligible[nbIdx] || cellDomain[nbIdx] >= 0)
+                    continue;
+
+                cellDomain[nbIdx] = domainIdx;
+                queue.push_back(nbIdx);
+                ++domainSize;
+            }
+        }
+        ++domainIdx;
+    }
+
+    return cellDomain;
+}
+
+std::vector<int>
+colorLocalDomains(const std::vector<std::vector<int>>& neighbours,
+                  const std::vector<int>& cellDomain,
+                  const int numDomains)
+{
+    // the neighbouring subdomains with a lower index
+    std::vector<std::vector<int>> lowerNeighbours(numDomains);
+    const int numCells = neighbours.size();
+    for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+        const int domainIdx = cellDomain[cellIdx];
+        if (domainIdx < 0)
+            continue;
+
+        for (const int nbIdx : neighbours[cellIdx]) {
+            const int nbDomainIdx = cellDomain[nbIdx];
+            if (nbDomainIdx >= 0 && nbDomainIdx < domainIdx)
+                lowerNeighbours[domainIdx].push_back(nbDomainIdx);
+        }
+    }
+
+    std::vector<int> colors(numDomains, 0);
+    std::vector<int> neighbourColors;
+    for (int domainIdx = 0; domainIdx < numDomains; ++domainIdx) {
+        neighbourColors.clear();
+        for (const int nbDomainIdx : lowerNeighbours[domainIdx])
+            neighbourColors.push_back(colors[nbDomainIdx]);
+        std::sort(neighbourColors.begin(), neighbourColors.end());
+
+        int color = 0;
+        for (const int nbColor : neighbourColors) {
+            if (nbColor == color)
+                ++color;
+            else if (nbColor > color)
+                break;
+        }
+        colors[domainIdx] = color;
+    }
+
+    return colors;
+}
+
+} // namespace Opm
@@ -0,0 +1,60 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LOCALDOMAINPARTITIONING_HEADER_INCLUDED
+#define OPM_LOCALDOMAINPARTITIONING_HEADER_INCLUDED
+
+#include <vector>
+
+namespace Opm {
+
+    /// Partition the eligible cells into connected subdomains of about the
+    /// same size by growing them breadth first from the lowest unassigned
+    /// cell.
+    ///
+    /// \param[in] neighbours The neighbouring cells of each cell.
+    /// \param[in] eligible Whether a cell may be part of a subdomain.
+    /// \param[in] numTargetDomains The requested number of subdomains.
+    ///   More subdomains are created if the eligible cells are not
+    ///   connected, fewer if there are fewer eligible cells.
+    ///
+    /// \return The subdomain of each cell, -1 for cells which are not
+    ///   eligible. The subdomains are numbered consecutively from zero.
+    std::vector<int>
+    partitionLocalDomains(const std::vector<std::vector<int>>& neighbours,
+                          const std::vector<char>& eligible,
+                          const int numTargetDomains);
+
+    /// Color the subdomains such that no two neighbouring subdomains have
+    /// the same color, assigning each subdomain in turn the smallest color
+    /// not used by its neighbours with a lower index.
+    ///
+    /// \param[in] neighbours The neighbouring cells of each cell.
+    /// \param[in] cellDomain The subdomain of each cell, -1 for none.
+    /// \param[in] numDomains The number of subdomains.
+    ///
+    /// \return The color of each subdomain.
+    std::vector<int>
+    colorLocalDomains(const std::vector<std::vector<int>>& neighbours,
+                      const std::vector<int>& cellDomain,
+                      const int numDomains);
+
+} // namespace Opm
+
+#endif // OPM_LOCALDOMAINPARTITIONING_HEADER_INCLUDED
@@ -0,0 +1,176 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/linalg/ComponentSweepSolver.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <algorithm>
+#include <utility>
+
+namespace Opm
+{
+
+bool findComponentOrdering(const ComponentSweepMatrix& M,
+                           const int maxComponentSize,
+                           ComponentOrdering& ordering)
+{
+    // Tarjan's algorithm with an explicit call stack. A component is
+    // only completed after all components it depends on, so the
+    // components are found in the order they can be solved.
+    using ColIterator = ComponentSweepMatrix::ConstColIterator;
+    const std::size_t numRows = M.N();
+    std::vector<int> index(numRows, -1);
+    std::vector<int> lowLink(numRows, 0);
+    std::vector<char> onStack(numRows, 0);
+    std::vector<unsigned> stack;
+    std::vector<std::pair<unsigned, ColIterator>> callStack;
+    int counter = 0;
+
+    ordering.order.clear();
+    ordering.componentStart.assign(1, 0);
+    for (unsigned root = 0; root < numRows; ++root) {
+        if (index[root] >= 0)
+            continue;
+
+        index[root] = lowLink[root] = counter++;
+        stack.push_back(root);
+        onStack[root] = 1;
+        callStack.emplace_back(root, M[root].begin());
+
+        while (!callStack.empty()) {
+            const unsigned v = callStack.back().first;
+            auto& colIt = callStack.back().second;
+
+            bool descend = false;
+            for (; colIt != M[v].end(); ++colIt) {
+                const unsigned w = colIt.index();
+                if (w == v || (*colIt)[0][0] == 0.0)
+                    continue;
+
+                if (index[w] < 0) {
+                    index[w] = lowLink[w] = counter++;
+                    stack.push_back(w);
+                    onStack[w] = 1;
+                    ++colIt;
+                    callStack.emplace_back(w, M[w].begin());
+                    descend = true;
+                    break;
+                }
+                if (onStack[w])
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+            }
+            if (descend)
+                continue;
+
+            if (lowLink[v] == index[v]) {
+                unsigned w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = 0;
+                    ordering.order.push_back(w);
+                } while (w != v);
+
+                const std::size_t size = ordering.order.size() - ordering.componentStart.back();
+                if (size > static_cast<std::size_t>(std::max(maxComponentSize, 1)))
+                    return false;
+                ordering.componentStart.push_back(ordering.order.size());
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                const unsigned u = callStack.back().first;
+                lowLink[u] = std::min(lowLink[u], lowLink[v]);
+            }
+        }
+    }
+
+    return true;
+}
+
+void componentSweepSolve(const ComponentSweepMatrix& M,
+                         const ComponentOrdering& ordering,
+                         const std::vector<int>& indices,
+                         std::vector<ComponentSweepVector>& x,
+                         const std::vector<ComponentSweepVector>& b)
+{
+    for (const auto& idx : indices)
+        x[idx] = 0.0;
+
+    // The rows a component depends on are either already solved or part
+    // of the component itself, and the entries of the latter are still
+    // zero in x.
+    const auto& order = ordering.order;
+    const auto& componentStart = ordering.componentStart;
+    std::vector<int> localIdx(M.N(), -1);
+    for (std::size_t compIdx = 0; compIdx + 1 < componentStart.size(); ++compIdx) {
+        const std::size_t begin = componentStart[compIdx];
+        const std::size_t size = componentStart[compIdx + 1] - begin;
+
+        if (size == 1) {
+            const unsigned rowIdx = order[begin];
+            const auto& row = M[rowIdx];
+            for (const auto& idx : indices) {
+                double rhs = b[idx][rowIdx][0];
+                for (auto colIt = row.begin(); colIt != row.end(); ++colIt)
+                    if (colIt.index() != rowIdx)
+                        rhs -= (*colIt)[0][0] * x[idx][colIt.index()][0];
+                x[idx][rowIdx] = rhs / row[rowIdx][0][0];
+            }
+            continue;
+        }
+
+        // a cycle: solve the small dense system directly
+        for (std::size_t i = 0; i < size; ++i)
+            localIdx[order[begin + i]] = i;
+
+        Dune::DynamicMatrix<double> A(size, size, 0.0);
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto& row = M[order[begin + i]];
+            for (auto colIt = row.begin(); colIt != row.end(); ++colIt)
+                if (localIdx[colIt.index()] >= 0)
+                    A[i][localIdx[colIt.index()]] = (*colIt)[0][0];
+        }
+        A.invert();
+
+        Dune::DynamicVector<double> rhs(size);
+        Dune::DynamicVector<double> sol(size);
+        for (const auto& idx : indices) {
+            for (std::size_t i = 0; i < size; ++i) {
+                const unsigned rowIdx = order[begin + i];
+                const auto& row = M[rowIdx];
+                rhs[i] = b[idx][rowIdx][0];
+                for (auto colIt = row.begin(); colIt != row.end(); ++colIt)
+                    if (localIdx[colIt.index()] < 0)
+                        rhs[i] -= (*colIt)[0][0] * x[idx][colIt.index()][0];
+            }
+            A.mv(rhs, sol);
+            for (std::size_t i = 0; i < size; ++i)
+                x[idx][order[begin + i]] = sol[i];
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+            localIdx[order[begin + i]] = -1;
+    }
+}
+
+} // namespace Opm
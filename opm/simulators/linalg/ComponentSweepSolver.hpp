@@ -0,0 +1,69 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_COMPONENTSWEEPSOLVER_HEADER_INCLUDED
+#define OPM_COMPONENTSWEEPSOLVER_HEADER_INCLUDED
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+
+using ComponentSweepMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+using ComponentSweepVector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+/// The strongly connected components of the graph of a matrix, in an
+/// order in which they can be solved one after the other.
+struct ComponentOrdering
+{
+    /// The rows, grouped by component.
+    std::vector<unsigned> order;
+    /// Start of each component in order, followed by the size of order.
+    std::vector<std::size_t> componentStart;
+};
+
+/// Find the strongly connected components of the graph of \p M with
+/// Tarjan's algorithm.
+///
+/// Row i depends on the rows of its nonzero off-diagonal entries, and a
+/// component is placed after all components it depends on.
+///
+/// \return False if a component has more than \p maxComponentSize rows,
+///         in which case \p ordering is incomplete.
+bool findComponentOrdering(const ComponentSweepMatrix& M,
+                           const int maxComponentSize,
+                           ComponentOrdering& ordering);
+
+/// Solve M x[i] = b[i] for each i in \p indices by a single sweep over the
+/// components of \p ordering. Components with one row are solved by
+/// substitution, larger ones by a dense direct solve.
+void componentSweepSolve(const ComponentSweepMatrix& M,
+                         const ComponentOrdering& ordering,
+                         const std::vector<int>& indices,
+                         std::vector<ComponentSweepVector>& x,
+                         const std::vector<ComponentSweepVector>& b);
+
+} // namespace Opm
+
+#endif // OPM_COMPONENTSWEEPSOLVER_HEADER_INCLUDED
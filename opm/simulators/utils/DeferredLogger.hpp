@@ -86,6 +86,12 @@ enum ExcEnum {
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Number of messages in the container.
+        std::size_t numMessages() const
+        {
+            return messages_.size();
+        }
+
     private:
         std::vector<Message> messages_;
         friend DeferredLogger gatherDeferredLogger(const DeferredLogger& local_deferredlogger);
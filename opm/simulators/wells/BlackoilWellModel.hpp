@@ -66,6 +66,8 @@
 #include <opm/simulators/wells/MultisegmentWell.hpp>
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
+#include <opm/simulators/wells/WellPotentialSnapshot.hpp>
+#include <opm/simulators/wells/WellThpLimitSolver.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/timestepping/gatherConvergenceReport.hpp>
 #include <dune/common/fmatrix.hh>
@@ -321,6 +323,21 @@ namespace Opm {
                 this->active_wgstate_ = this->last_valid_wgstate_;
             }
 
+            /*
+              The currently active well and group state. A copy taken with
+              activeWGState() can be restored with setActiveWGState(), e.g. to
+              undo changes made while assembling from a discarded initial guess.
+            */
+            const WGState& activeWGState() const
+            {
+                return this->active_wgstate_;
+            }
+
+            void setActiveWGState(WGState wgstate)
+            {
+                this->active_wgstate_ = std::move(wgstate);
+            }
+
             /*
               Will store the current active wellstate in the nupcol_well_state_
               member. This can then be subsequently retrieved with accessor
@@ -364,8 +381,19 @@ namespace Opm {
             // apply well model with scaling of alpha
             void applyScaleAdd(const Scalar alpha, const BVector& x, BVector& Ax) const;
 
-            // Check if well equations is converged.
-            ConvergenceReport getWellConvergence(const std::vector<Scalar>& B_avg, const bool checkGroupConvergence = false) const;
+            // Check the well equations of the wells on this process without
+            // any communication.
+            ConvergenceReport getLocalWellConvergence(const std::vector<Scalar>& B_avg,
+                                                      DeferredLogger& local_deferredLogger) const;
+
+            // Combine the local convergence reports of all processes. The
+            // well failures and messages are only gathered if some process
+            // has any, which the caller has to know from a global reduction.
+            ConvergenceReport gatherWellConvergence(const ConvergenceReport& local_report,
+                                                    const DeferredLogger& local_deferredLogger,
+                                                    const bool anyWellFailed,
+                                                    const bool anyMessages,
+                                                    const bool checkGroupConvergence = false) const;
 
             const PhaseUsage& phaseUsage() const { return phase_usage_; }
 
@@ -471,6 +499,7 @@ namespace Opm {
 
             std::unique_ptr<RateConverterType> rateConverter_{};
             std::unique_ptr<VFPProperties> vfp_properties_{};
+            WellThpLimitCache thp_limit_cache_{};
 
             SimulatorReportSingle last_report_{};
 
@@ -478,6 +507,8 @@ namespace Opm {
             std::unique_ptr<GuideRate> guideRate_{};
 
             std::map<std::string, double> node_pressures_{}; // Storing network pressures for output.
+
+            std::unordered_map<std::string, WellPotentialSnapshot> well_potential_snapshots_{};
             mutable std::unordered_set<std::string> closed_this_step_{};
 
             // used to better efficiency of calcuation
@@ -539,6 +570,13 @@ namespace Opm {
             // Calculating well potentials for each well
             void updateWellPotentials(const int reportStepIdx, const bool onlyAfterEvent, DeferredLogger& deferred_logger);
 
+            // Snapshot of the quantities the potentials of a well depend on
+            WellPotentialSnapshot makeWellPotentialSnapshot(const WellInterface<TypeTag>& well) const;
+
+            // Whether the potentials from the last computation can be reused for a well
+            bool canReuseWellPotentials(const WellInterface<TypeTag>& well,
+                                        const WellPotentialSnapshot& current) const;
+
             const std::vector<double>& wellPerfEfficiencyFactors() const;
 
             void calculateEfficiencyFactors(const int reportStepIdx);
@@ -314,6 +314,7 @@ namespace Opm {
     beginTimeStep()
     {
         updatePerforationIntensiveQuantities();
+        thp_limit_cache_.newReservoirState(ebosSimulator_.episodeIndex());
         updateAverageFormationFactor();
 
         DeferredLogger local_deferredLogger;
@@ -373,6 +374,7 @@ namespace Opm {
         for (auto& well : well_container_) {
             well->setVFPProperties(vfp_properties_.get());
             well->setGuideRate(guideRate_.get());
+            well->setThpLimitCache(&thp_limit_cache_);
         }
 
         // Close completions due to economical reasons
@@ -556,6 +558,9 @@ namespace Opm {
         // update the rate converter with current averages pressures etc in
         rateConverter_->template defineState<ElementContext>(ebosSimulator_);
 
+        // the converged solution differs from the state of the last assembly
+        thp_limit_cache_.newReservoirState(reportStepIdx);
+
         // calculate the well potentials
         try {
             updateWellPotentials(reportStepIdx, /*onlyAfterEvent*/false, local_deferredLogger);
@@ -1040,6 +1045,7 @@ namespace Opm {
 
 
         updatePerforationIntensiveQuantities();
+        thp_limit_cache_.newReservoirState(ebosSimulator_.episodeIndex());
 
         auto exc_type = ExceptionType::NONE;
         std::string exc_msg;
@@ -1321,23 +1327,41 @@ namespace Opm {
     template<typename TypeTag>
     ConvergenceReport
     BlackoilWellModel<TypeTag>::
-    getWellConvergence(const std::vector<Scalar>& B_avg, bool checkGroupConvergence) const
+    getLocalWellConvergence(const std::vector<Scalar>& B_avg,
+                            DeferredLogger& local_deferredLogger) const
     {
-
-        DeferredLogger local_deferredLogger;
-        // Get global (from all processes) convergence report.
         ConvergenceReport local_report;
         for (const auto& well : well_container_) {
             if (well->isOperable() ) {
                 local_report += well->getWellConvergence(this->wellState(), B_avg, local_deferredLogger);
             }
         }
-        DeferredLogger global_deferredLogger = gatherDeferredLogger(local_deferredLogger);
+        return local_report;
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    ConvergenceReport
+    BlackoilWellModel<TypeTag>::
+    gatherWellConvergence(const ConvergenceReport& local_report,
+                          const DeferredLogger& local_deferredLogger,
+                          const bool anyWellFailed,
+                          const bool anyMessages,
+                          const bool checkGroupConvergence) const
+    {
+        DeferredLogger global_deferredLogger = anyMessages
+            ? gatherDeferredLogger(local_deferredLogger)
+            : local_deferredLogger;
         if (terminal_output_) {
             global_deferredLogger.logMessages();
         }
 
-        ConvergenceReport report = gatherConvergenceReport(local_report);
+        ConvergenceReport report = anyWellFailed
+            ? gatherConvergenceReport(local_report)
+            : local_report;
 
         // Log debug messages for NaN or too large residuals.
         if (terminal_output_) {
@@ -1595,6 +1619,21 @@ namespace Opm {
             const bool compute_potential = needPotentialsForOutput || needPotentialsForGuideRates;
             if (compute_potential)
             {
+                // Unless there is an event for the well, reuse the previous
+                // potentials if the connection cells and the control did not
+                // change noticeably since they were computed.
+                std::optional<WellPotentialSnapshot> snapshot;
+                if (param_.well_potential_update_tolerance_ > 0.0) {
+                    snapshot = makeWellPotentialSnapshot(*well);
+                    if (!event && canReuseWellPotentials(*well, *snapshot)) {
+                        const auto& potentials = well_potential_snapshots_.at(well->name()).potentials;
+                        for (int p = 0; p < np; ++p) {
+                            this->wellState().wellPotentials()[well->indexOfWell() * np + p] = potentials[p];
+                        }
+                        continue;
+                    }
+                }
+
                 std::vector<double> potentials;
                 try {
                     well->computeWellPotentials(ebosSimulator_, well_state_copy, potentials, deferred_logger);
@@ -1617,6 +1656,15 @@ namespace Opm {
                 for (int p = 0; p < np; ++p) {
                     this->wellState().wellPotentials()[well->indexOfWell() * np + p] = std::abs(potentials[p]);
                 }
+                if (snapshot) {
+                    if (exc_type == ExceptionType::NONE) {
+                        snapshot->potentials.assign(this->wellState().wellPotentials().begin() + well->indexOfWell() * np,
+                                                    this->wellState().wellPotentials().begin() + (well->indexOfWell() + 1) * np);
+                        well_potential_snapshots_[well->name()] = std::move(*snapshot);
+                    } else {
+                        well_potential_snapshots_.erase(well->name());
+                    }
+                }
             }
         }
         logAndCheckForExceptionsAndThrow(deferred_logger, exc_type,
@@ -1629,6 +1677,80 @@ namespace Opm {
 
 
 
+    template<typename TypeTag>
+    WellPotentialSnapshot
+    BlackoilWellModel<TypeTag>::
+    makeWellPotentialSnapshot(const WellInterface<TypeTag>& well) const
+    {
+        WellPotentialSnapshot snapshot;
+        const auto& well_cells = well.cells();
+        snapshot.cell_pressures.reserve(well_cells.size());
+        snapshot.cell_mobilities.reserve(well_cells.size());
+        for (const int cell_idx : well_cells) {
+            const auto& intQuants = *(ebosSimulator_.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0));
+            const auto& fs = intQuants.fluidState();
+            // copy of get perfpressure in Standard well except for value
+            if (Indices::oilEnabled) {
+                snapshot.cell_pressures.push_back(fs.pressure(FluidSystem::oilPhaseIdx).value());
+            } else if (Indices::waterEnabled) {
+                snapshot.cell_pressures.push_back(fs.pressure(FluidSystem::waterPhaseIdx).value());
+            } else {
+                snapshot.cell_pressures.push_back(fs.pressure(FluidSystem::gasPhaseIdx).value());
+            }
+            double total_mobility = 0.0;
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                if (FluidSystem::phaseIsActive(phaseIdx)) {
+                    total_mobility += intQuants.mobility(phaseIdx).value();
+                }
+            }
+            snapshot.cell_mobilities.push_back(total_mobility);
+        }
+        const auto well_index = well.indexOfWell();
+        snapshot.control_mode = well.isInjector()
+            ? static_cast<int>(this->wellState().currentInjectionControl(well_index))
+            : static_cast<int>(this->wellState().currentProductionControl(well_index));
+
+        // The limits may change without a schedule event, e.g. through UDQs.
+        const auto& summaryState = ebosSimulator_.vanguard().summaryState();
+        const auto& well_ecl = well.wellEcl();
+        if (well.isInjector()) {
+            const auto controls = well_ecl.injectionControls(summaryState);
+            snapshot.limits = {controls.bhp_limit, controls.thp_limit,
+                               controls.surface_rate, controls.reservoir_rate};
+        } else {
+            const auto controls = well_ecl.productionControls(summaryState);
+            snapshot.limits = {controls.bhp_limit, controls.thp_limit,
+                               controls.oil_rate, controls.water_rate, controls.gas_rate,
+                               controls.liquid_rate, controls.resv_rate};
+        }
+        snapshot.stopped = well.wellIsStopped();
+        snapshot.operable = well.isOperable();
+        return snapshot;
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    bool
+    BlackoilWellModel<TypeTag>::
+    canReuseWellPotentials(const WellInterface<TypeTag>& well,
+                           const WellPotentialSnapshot& current) const
+    {
+        // The decision must be the same on all processes sharing the well,
+        // since the potential calculation communicates for distributed wells.
+        const auto last = well_potential_snapshots_.find(well.name());
+        const int can_reuse = last != well_potential_snapshots_.end() &&
+            Opm::canReuseWellPotentials(last->second, current,
+                                        param_.well_potential_update_tolerance_);
+        return well.parallelWellInfo().communication().min(can_reuse) == 1;
+    }
+
+
+
+
+
 
     template <typename TypeTag>
     void
@@ -25,6 +25,8 @@
 #include <opm/simulators/wells/WellState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/GasLiftOpt.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <optional>
 #include <string>
@@ -467,61 +469,118 @@ getGroupGliftWellsRecursive_(const Group &group,
     }
 }
 
+template<typename TypeTag>
+typename GasLiftStage2<TypeTag>::GradPairItr
+GasLiftStage2<TypeTag>::
+maxGradient_(std::vector<GradPair> &grads)
+{
+    auto cmp = [](const GradPair &a, const GradPair &b) {
+         return a.second <  b.second;
+    };
+    return std::max_element(grads.begin(), grads.end(), cmp);
+}
+
+template<typename TypeTag>
+typename GasLiftStage2<TypeTag>::GradPairItr
+GasLiftStage2<TypeTag>::
+minGradient_(std::vector<GradPair> &grads, const std::string* exclude_name)
+{
+    auto min_itr = grads.end();
+    for (auto itr = grads.begin(); itr != grads.end(); ++itr) {
+        if (exclude_name && itr->first == *exclude_name)
+            continue;
+        if (min_itr == grads.end() || itr->second < min_itr->second)
+            min_itr = itr;
+    }
+    return min_itr;
+}
+
+// Synchronize both the incremental and the decremental gradient vectors
+//   across ranks. Each rank contributes the gradients of the wells it owns.
+//   Both vectors are exchanged in a single allgather/allgatherv pair
+//   instead of one pair per vector, since this is done once per
+//   redistribution step.
 template<typename TypeTag>
 void
 GasLiftStage2<TypeTag>::
-mpiSyncGlobalGradVector_(std::vector<GradPair> &grads_global) const
+mpiSyncGlobalGradVectors_(
+    std::vector<GradPair> &inc_grads_global,
+    std::vector<GradPair> &dec_grads_global) const
 {
     if (this->comm_.size() == 1)
         return;
 
-    std::vector<GradPair> grads_local;
-    for (auto itr = grads_global.begin(); itr != grads_global.end(); itr++) {
-        if (well_state_map_.count(itr->first) > 0) {
-            grads_local.push_back(*itr);
+    auto extract_local = [this](const std::vector<GradPair> &grads_global) {
+        std::vector<GradPair> grads_local;
+        for (const auto& grad : grads_global) {
+            if (well_state_map_.count(grad.first) > 0) {
+                grads_local.push_back(grad);
+            }
         }
-    }
-    mpiSyncLocalToGlobalGradVector_(grads_local, grads_global);
+        return grads_local;
+    };
+    mpiSyncLocalToGlobalGradVectors_(
+        extract_local(inc_grads_global), extract_local(dec_grads_global),
+        inc_grads_global, dec_grads_global);
 }
 
 template<typename TypeTag>
 void
 GasLiftStage2<TypeTag>::
-mpiSyncLocalToGlobalGradVector_(
-    const std::vector<GradPair> &grads_local, std::vector<GradPair> &grads_global) const
+mpiSyncLocalToGlobalGradVectors_(
+    const std::vector<GradPair> &inc_grads_local,
+    const std::vector<GradPair> &dec_grads_local,
+    std::vector<GradPair> &inc_grads_global,
+    std::vector<GradPair> &dec_grads_global) const
 {
     assert(this->comm_.size() > 1);  // The parent should check if comm. size is > 1
     using Pair = std::pair<int, double>;
+    // Pack the owned incremental gradients followed by the owned
+    //   decremental gradients into a single send buffer.
     std::vector<Pair> grads_local_tmp;
-    grads_local_tmp.reserve(grads_local.size());
-    for (size_t i = 0; i < grads_local.size(); ++i) {
-        if(!this->well_state_.wellIsOwned(grads_local[i].first))
-            continue;
-        grads_local_tmp.push_back(
-           std::make_pair(
-              this->well_state_.wellNameToGlobalIdx(grads_local[i].first),
-              grads_local[i].second));
+    grads_local_tmp.reserve(inc_grads_local.size() + dec_grads_local.size());
+    auto pack = [this, &grads_local_tmp](const std::vector<GradPair> &grads_local) {
+        int count = 0;
+        for (const auto& grad : grads_local) {
+            if(!this->well_state_.wellIsOwned(grad.first))
+                continue;
+            grads_local_tmp.emplace_back(
+                this->well_state_.wellNameToGlobalIdx(grad.first), grad.second);
+            ++count;
+        }
+        return count;
+    };
+    const int num_inc = pack(inc_grads_local);
+    const int num_dec = pack(dec_grads_local);
+
+    const int comm_size = this->comm_.size();
+    std::array<int, 2> my_sizes = {num_inc, num_dec};
+    std::vector<int> all_sizes(2 * comm_size);
+    this->comm_.allgather(my_sizes.data(), 2, all_sizes.data());
+    std::vector<int> sizes_(comm_size);
+    std::vector<int> displ_(comm_size + 1, 0);
+    for (int rank = 0; rank < comm_size; ++rank) {
+        sizes_[rank] = all_sizes[2*rank] + all_sizes[2*rank + 1];
     }
-
-    std::vector<int> sizes_(this->comm_.size());
-    std::vector<int> displ_(this->comm_.size() + 1, 0);
-    int mySize = grads_local_tmp.size();
-    this->comm_.allgather(&mySize, 1, sizes_.data());
     std::partial_sum(sizes_.begin(), sizes_.end(), displ_.begin()+1);
     std::vector<Pair> grads_global_tmp(displ_.back());
 
     this->comm_.allgatherv(grads_local_tmp.data(), grads_local_tmp.size(),
         grads_global_tmp.data(), sizes_.data(), displ_.data());
 
-    // NOTE: This leaves the capacity of 'grads_global' unchanged, so
+    // NOTE: This leaves the capacity of the global vectors unchanged, so
     //   memory is not reallocated here
-    grads_global.clear();
-
-    for (size_t i = 0; i < grads_global_tmp.size(); ++i) {
-        grads_global.emplace_back(
-            std::make_pair(
+    inc_grads_global.clear();
+    dec_grads_global.clear();
+
+    for (int rank = 0; rank < comm_size; ++rank) {
+        const int inc_end = displ_[rank] + all_sizes[2*rank];
+        for (int i = displ_[rank]; i < displ_[rank + 1]; ++i) {
+            auto& grads_global = (i < inc_end) ? inc_grads_global : dec_grads_global;
+            grads_global.emplace_back(
                 well_state_.globalIdxToWellName(grads_global_tmp[i].first),
-                grads_global_tmp[i].second));
+                grads_global_tmp[i].second);
+        }
     }
 }
 
@@ -678,8 +737,8 @@ redistributeALQ_(std::vector<GasLiftSingleWell *> &wells,  const Group &group,
         dec_grads_local.reserve(wells.size());
         state.calculateEcoGradients(wells, inc_grads_local, dec_grads_local);
         // the gradients needs to be communicated to all ranks
-        mpiSyncLocalToGlobalGradVector_(dec_grads_local, dec_grads);
-        mpiSyncLocalToGlobalGradVector_(inc_grads_local, inc_grads);
+        mpiSyncLocalToGlobalGradVectors_(
+            inc_grads_local, dec_grads_local, inc_grads, dec_grads);
     }
 
     if (!state.checkAtLeastTwoWells(wells)) {
@@ -751,10 +810,9 @@ removeSurplusALQ_(const Group &group,
             min_eco_grad, controls.oil_target, controls.gas_target, max_glift };
 
     while (!stop_iteration) {
-        if (dec_grads.size() >= 2) {
-            sortGradients_(dec_grads);
-        }
-        auto dec_grad_itr = dec_grads.begin();
+        // Only the smallest decremental gradient is needed, so a linear
+        //   search is sufficient (no need to sort the whole vector)
+        auto dec_grad_itr = minGradient_(dec_grads);
         const auto well_name = dec_grad_itr->first;
         auto eco_grad = dec_grad_itr->second;
         bool remove = false;
@@ -762,11 +820,10 @@ removeSurplusALQ_(const Group &group,
             remove = true;
         }
         else {
-            // NOTE: It is enough to check the economic gradient of the first well
-            //   in dec_grads since they are sorted according to the eco. grad.
-            //   If the first well's eco. grad. is greater than the minimum
-            //   eco. grad. then all the other wells' eco. grad. will also be
-            //   greater.
+            // NOTE: It is enough to check the economic gradient of the well
+            //   with the smallest decremental gradient. If this well's eco. grad.
+            //   is greater than the minimum eco. grad. then all the other wells'
+            //   eco. grad. will also be greater.
             if (state.checkEcoGradient(well_name, eco_grad)) remove = true;
         }
         if (remove) {
@@ -776,8 +833,7 @@ removeSurplusALQ_(const Group &group,
                         dec_grad_itr, /*increase=*/false, dec_grads, inc_grads);
 
             // The dec_grads and inc_grads needs to be syncronized across ranks
-            mpiSyncGlobalGradVector_(dec_grads);
-            mpiSyncGlobalGradVector_(inc_grads);
+            mpiSyncGlobalGradVectors_(inc_grads, dec_grads);
             // NOTE: recalculateGradientAndUpdateData_() will remove the current gradient
             //   from dec_grads if it cannot calculate a new decremental gradient.
             //   This will invalidate dec_grad_itr and well_name
@@ -833,17 +889,6 @@ saveIncGrad_(const std::string &name, GradInfo &grad)
     saveGrad_(this->inc_grads_, name, grad);
 }
 
-template<typename TypeTag>
-void
-GasLiftStage2<TypeTag>::
-sortGradients_(std::vector<GradPair> &grads)
-{
-    auto cmp = [](GradPair a, GradPair b) {
-         return a.second <  b.second;
-    };
-    std::sort(grads.begin(), grads.end(), cmp);
-}
-
 template<typename TypeTag>
 std::optional<typename GasLiftStage2<TypeTag>::GradInfo>
 GasLiftStage2<TypeTag>::
@@ -939,23 +984,15 @@ GasLiftStage2<TypeTag>::OptimizeState::
 getEcoGradients(std::vector<GradPair> &inc_grads, std::vector<GradPair> &dec_grads)
 {
     if (inc_grads.size() > 0 && dec_grads.size() > 0) {
-        this->parent.sortGradients_(inc_grads);
-        this->parent.sortGradients_(dec_grads);
-        // The largest incremental gradient is the last element
-        auto inc_grad = std::prev(inc_grads.end());
-        std::optional<GradPairItr> inc_grad_opt;
-        std::optional<GradPairItr> dec_grad_opt;
-        // The smallest decremental gradient is at the beginning
-        for (auto itr = dec_grads.begin(); itr != dec_grads.end(); itr++) {
-            if (itr->first == inc_grad->first) {
-                // Don't consider decremental gradients with the same well name
-                continue;
-            }
-            dec_grad_opt = itr;
-            break;
-        }
-        if (dec_grad_opt) {
-            inc_grad_opt = inc_grad;
+        // NOTE: Only the largest incremental gradient and the smallest
+        //   decremental gradient are needed in each iteration, so we locate
+        //   them with a linear search instead of sorting both vectors.
+        auto inc_grad = this->parent.maxGradient_(inc_grads);
+        // Don't consider decremental gradients with the same well name
+        auto dec_grad = this->parent.minGradient_(dec_grads, &inc_grad->first);
+        if (dec_grad != dec_grads.end()) {
+            std::optional<GradPairItr> inc_grad_opt = inc_grad;
+            std::optional<GradPairItr> dec_grad_opt = dec_grad;
             return { dec_grad_opt, inc_grad_opt };
         }
     }
@@ -988,8 +1025,7 @@ recalculateGradients(
         min_dec_grad_itr, /*increase=*/false, dec_grads, inc_grads);
 
     // The dec_grads and inc_grads needs to be syncronized across ranks
-    this->parent.mpiSyncGlobalGradVector_(dec_grads);
-    this->parent.mpiSyncGlobalGradVector_(inc_grads);
+    this->parent.mpiSyncGlobalGradVectors_(inc_grads, dec_grads);
 }
 
 // Take one ALQ increment from well1, and give it to well2
@@ -521,7 +521,9 @@ namespace Opm
                                                       const SummaryState& summary_state,
                                                       DeferredLogger& deferred_logger) const;
 
-        double maxPerfPress(const Simulator& ebos_simulator) const;
+        // Explicit quantities of the well that the inflow relation depends
+        // on, used to validate the cached thp limit solutions.
+        std::vector<double> thpLimitCacheKey() const;
 
         // pressure drop for Spiral ICD segment (WSEGSICD)
         EvalWell pressureDropSpiralICD(const int seg) const;
@@ -3310,7 +3310,10 @@ namespace Opm
         //
         // This may result in 0, 1 or 2 solutions. If two solutions,
         // the one corresponding to the lowest bhp (and therefore
-        // highest rate) should be returned.
+        // highest rate) is returned.
+        //
+        // The equation is solved by WellThpLimitSolver, which also
+        // caches the samples of the inflow relation for this well.
 
         // Make the fbhp() function.
         const auto& controls = well_ecl_.productionControls(summary_state);
@@ -3322,7 +3325,16 @@ namespace Opm
         auto fbhp = [this, &controls, thp_limit, dp](const std::vector<double>& rates) {
             assert(rates.size() == 3);
             return this->vfp_properties_->getProd()
-            ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit, controls.alq_value) - dp;
+            ->bhpWithHint(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas],
+                          thp_limit, controls.alq_value, this->vfp_prod_hint_).value - dp;
+        };
+        auto fbhp_samples = [this, &controls, thp_limit, dp](const std::vector<std::vector<double>>& rates) {
+            std::vector<double> bhps = this->vfp_properties_->getProd()
+            ->bhps(controls.vfp_table_number, rates, thp_limit, controls.alq_value, this->vfp_prod_hint_);
+            for (double& bhp : bhps) {
+                bhp -= dp;
+            }
+            return bhps;
         };
 
         // Make the flo() function.
@@ -3342,147 +3354,13 @@ namespace Opm
             return rates;
         };
 
-        // Find the bhp-point where production becomes nonzero.
-        double bhp_max = 0.0;
-        {
-            auto fflo = [&flo, &frates](double bhp) { return flo(frates(bhp)); };
-            double low = controls.bhp_limit;
-            double high = maxPerfPress(ebos_simulator) + 1.0 * unit::barsa;
-            double f_low = fflo(low);
-            double f_high = fflo(high);
-            deferred_logger.debug("computeBhpAtThpLimitProd(): well = " + name() +
-                                  "  low = " + std::to_string(low) +
-                                  "  high = " + std::to_string(high) +
-                                  "  f(low) = " + std::to_string(f_low) +
-                                  "  f(high) = " + std::to_string(f_high));
-            int adjustments = 0;
-            const int max_adjustments = 10;
-            const double adjust_amount = 5.0 * unit::barsa;
-            while (f_low * f_high > 0.0 && adjustments < max_adjustments) {
-                // Same sign, adjust high to see if we can flip it.
-                high += adjust_amount;
-                f_high = fflo(high);
-                ++adjustments;
-            }
-            if (f_low * f_high > 0.0) {
-                if (f_low > 0.0) {
-                    // Even at the BHP limit, we are injecting.
-                    // There will be no solution here, return an
-                    // empty optional.
-                    deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_INOPERABLE",
-                                            "Robust bhp(thp) solve failed due to inoperability for well " + name());
-                    return std::optional<double>();
-                } else {
-                    // Still producing, even at high bhp.
-                    assert(f_high < 0.0);
-                    bhp_max = high;
-                }
-            } else {
-                // Bisect to find a bhp point where we produce, but
-                // not a large amount ('eps' below).
-                const double eps = 0.1 * std::fabs(table.getFloAxis().front());
-                const int maxit = 50;
-                int it = 0;
-                while (std::fabs(f_low) > eps && it < maxit) {
-                    const double curr = 0.5*(low + high);
-                    const double f_curr = fflo(curr);
-                    if (f_curr * f_low > 0.0) {
-                        low = curr;
-                        f_low = f_curr;
-                    } else {
-                        high = curr;
-                        f_high = f_curr;
-                    }
-                    ++it;
-                }
-                bhp_max = low;
-            }
-            deferred_logger.debug("computeBhpAtThpLimitProd(): well = " + name() +
-                                  "  low = " + std::to_string(low) +
-                                  "  high = " + std::to_string(high) +
-                                  "  f(low) = " + std::to_string(f_low) +
-                                  "  f(high) = " + std::to_string(f_high) +
-                                  "  bhp_max = " + std::to_string(bhp_max));
-        }
-
-        // Define the equation we want to solve.
-        auto eq = [&fbhp, &frates](double bhp) {
-            return fbhp(frates(bhp)) - bhp;
-        };
-
-        // Find appropriate brackets for the solution.
-        double low = controls.bhp_limit;
-        double high = bhp_max;
-        {
-            double eq_high = eq(high);
-            double eq_low = eq(low);
-            const double eq_bhplimit = eq_low;
-            deferred_logger.debug("computeBhpAtThpLimitProd(): well = " + name() +
-                                  "  low = " + std::to_string(low) +
-                                  "  high = " + std::to_string(high) +
-                                  "  eq(low) = " + std::to_string(eq_low) +
-                                  "  eq(high) = " + std::to_string(eq_high));
-            if (eq_low * eq_high > 0.0) {
-                // Failed to bracket the zero.
-                // If this is due to having two solutions, bisect until bracketed.
-                double abs_low = std::fabs(eq_low);
-                double abs_high = std::fabs(eq_high);
-                int bracket_attempts = 0;
-                const int max_bracket_attempts = 20;
-                double interval = high - low;
-                const double min_interval = 1.0 * unit::barsa;
-                while (eq_low * eq_high > 0.0 && bracket_attempts < max_bracket_attempts && interval > min_interval) {
-                    if (abs_high < abs_low) {
-                        low = 0.5 * (low + high);
-                        eq_low = eq(low);
-                        abs_low = std::fabs(eq_low);
-                    } else {
-                        high = 0.5 * (low + high);
-                        eq_high = eq(high);
-                        abs_high = std::fabs(eq_high);
-                    }
-                    ++bracket_attempts;
-                }
-                if (eq_low * eq_high > 0.0) {
-                    // Still failed bracketing!
-                    const double limit = 3.0 * unit::barsa;
-                    if (std::min(abs_low, abs_high) < limit) {
-                        // Return the least bad solution if less off than 3 bar.
-                        deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_BRACKETING_FAILURE",
-                                                "Robust bhp(thp) not solved precisely for well " + name());
-                        return abs_low < abs_high ? low : high;
-                    } else {
-                        // Return failure.
-                        deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_BRACKETING_FAILURE",
-                                                "Robust bhp(thp) solve failed due to bracketing failure for well " + name());
-                        return std::optional<double>();
-                    }
-                }
-            }
-            // We have a bracket!
-            // Now, see if (bhplimit, low) is a bracket in addition to (low, high).
-            // If so, that is the bracket we shall use, choosing the solution with the
-            // highest flow.
-            if (eq_low * eq_bhplimit <= 0.0) {
-                high = low;
-                low = controls.bhp_limit;
-            }
-        }
-
-        // Solve for the proper solution in the given interval.
-        const int max_iteration = 100;
-        const double bhp_tolerance = 0.01 * unit::barsa;
-        int iteration = 0;
-        try {
-            const double solved_bhp = RegulaFalsiBisection<ThrowOnError>::
-                solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
-            return solved_bhp;
-        }
-        catch (...) {
-            deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
-                                    "Robust bhp(thp) solve failed for well " + name());
-            return std::optional<double>();
-	}
+        return WellThpLimitSolver::computeBhpAtThpLimit(name(), /*is_producer*/ true, table.getFloAxis(),
+                                                        controls.bhp_limit, thp_limit, controls.alq_value,
+                                                        frates, flo, fbhp_samples, fbhp,
+                                                        thpLimitCacheEntry(controls.vfp_table_number,
+                                                                           controls.bhp_limit,
+                                                                           thpLimitCacheKey()),
+                                                        deferred_logger);
     }
 
 
@@ -3511,28 +3389,8 @@ namespace Opm
         // the one corresponding to the lowest bhp (and therefore
         // highest rate) is returned.
         //
-        // In order to detect these situations, we will find piecewise
-        // linear approximations both to the inverse of the frates
-        // function and to the fbhp function.
-        //
-        // We first take the FLO sample points of the VFP curve, and
-        // find the corresponding bhp values by solving the equation:
-        //     flo(frates(bhp)) - flo_sample = 0
-        // for bhp, for each flo_sample. The resulting (flo_sample,
-        // bhp_sample) values give a piecewise linear approximation to
-        // the true inverse inflow function, at the same flo values as
-        // the VFP data.
-        //
-        // Then we extract a piecewise linear approximation from the
-        // multilinear fbhp() by evaluating it at the flo_sample
-        // points, with fractions given by the frates(bhp_sample)
-        // values.
-        //
-        // When we have both piecewise linear curves defined on the
-        // same flo_sample points, it is easy to distinguish between
-        // the 0, 1 or 2 solution cases, and obtain the right interval
-        // in which to solve for the solution we want (with highest
-        // flow in case of 2 solutions).
+        // The equation is solved by WellThpLimitSolver, which also
+        // caches the samples of the inflow relation for this well.
 
         // Make the fbhp() function.
         const auto& controls = well_ecl_.injectionControls(summary_state);
@@ -3546,6 +3404,14 @@ namespace Opm
             return this->vfp_properties_->getInj()
                     ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit) - dp;
         };
+        auto fbhp_samples = [&fbhp](const std::vector<std::vector<double>>& rates) {
+            std::vector<double> bhps;
+            bhps.reserve(rates.size());
+            for (const auto& r : rates) {
+                bhps.push_back(fbhp(r));
+            }
+            return bhps;
+        };
 
         // Make the flo() function.
         auto flo = [&table](const std::vector<double>& rates) {
@@ -3564,126 +3430,13 @@ namespace Opm
             return rates;
         };
 
-        // Get the flo samples, add extra samples at low rates and bhp
-        // limit point if necessary.
-        std::vector<double> flo_samples = table.getFloAxis();
-        if (flo_samples[0] > 0.0) {
-            const double f0 = flo_samples[0];
-            flo_samples.insert(flo_samples.begin(), { f0/20.0, f0/10.0, f0/5.0, f0/2.0 });
-        }
-        const double flo_bhp_limit = flo(frates(controls.bhp_limit));
-        if (flo_samples.back() < flo_bhp_limit) {
-            flo_samples.push_back(flo_bhp_limit);
-        }
-
-        // Find bhp values for inflow relation corresponding to flo samples.
-        std::vector<double> bhp_samples;
-        for (double flo_sample : flo_samples) {
-            if (flo_sample > flo_bhp_limit) {
-                // We would have to go over the bhp limit to obtain a
-                // flow of this magnitude. We associate all such flows
-                // with simply the bhp limit. The first one
-                // encountered is considered valid, the rest not. They
-                // are therefore skipped.
-                bhp_samples.push_back(controls.bhp_limit);
-                break;
-            }
-            auto eq = [&flo, &frates, flo_sample](double bhp) {
-                return flo(frates(bhp)) - flo_sample;
-            };
-            // TODO: replace hardcoded low/high limits.
-            const double low = 10.0 * unit::barsa;
-            const double high = 800.0 * unit::barsa;
-            const int max_iteration = 100;
-            const double flo_tolerance = 0.05 * std::fabs(flo_samples.back());
-            int iteration = 0;
-            try {
-                const double solved_bhp = RegulaFalsiBisection<WarnAndContinueOnError>::
-                        solve(eq, low, high, max_iteration, flo_tolerance, iteration);
-                bhp_samples.push_back(solved_bhp);
-            }
-            catch (...) {
-                // Use previous value (or max value if at start) if we failed.
-                bhp_samples.push_back(bhp_samples.empty() ? low : bhp_samples.back());
-                deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_EXTRACT_SAMPLES",
-                                        "Robust bhp(thp) solve failed extracting bhp values at flo samples for well " + name());
-            }
-        }
-
-        // Find bhp values for VFP relation corresponding to flo samples.
-        const int num_samples = bhp_samples.size(); // Note that this can be smaller than flo_samples.size()
-        std::vector<double> fbhp_samples(num_samples);
-        for (int ii = 0; ii < num_samples; ++ii) {
-            fbhp_samples[ii] = fbhp(frates(bhp_samples[ii]));
-        }
-// #define EXTRA_THP_DEBUGGING
-#ifdef EXTRA_THP_DEBUGGING
-        std::string dbgmsg;
-        dbgmsg += "flo: ";
-        for (int ii = 0; ii < num_samples; ++ii) {
-            dbgmsg += "  " + std::to_string(flo_samples[ii]);
-        }
-        dbgmsg += "\nbhp: ";
-        for (int ii = 0; ii < num_samples; ++ii) {
-            dbgmsg += "  " + std::to_string(bhp_samples[ii]);
-        }
-        dbgmsg += "\nfbhp: ";
-        for (int ii = 0; ii < num_samples; ++ii) {
-            dbgmsg += "  " + std::to_string(fbhp_samples[ii]);
-        }
-        OpmLog::debug(dbgmsg);
-#endif // EXTRA_THP_DEBUGGING
-
-        // Look for sign changes for the (fbhp_samples - bhp_samples) piecewise linear curve.
-        // We only look at the valid
-        int sign_change_index = -1;
-        for (int ii = 0; ii < num_samples - 1; ++ii) {
-            const double curr = fbhp_samples[ii] - bhp_samples[ii];
-            const double next = fbhp_samples[ii + 1] - bhp_samples[ii + 1];
-            if (curr * next < 0.0) {
-                // Sign change in the [ii, ii + 1] interval.
-                sign_change_index = ii; // May overwrite, thereby choosing the highest-flo solution.
-            }
-        }
-
-        // Handle the no solution case.
-        if (sign_change_index == -1) {
-            return std::optional<double>();
-        }
-
-        // Solve for the proper solution in the given interval.
-        auto eq = [&fbhp, &frates](double bhp) {
-            return fbhp(frates(bhp)) - bhp;
-        };
-        // TODO: replace hardcoded low/high limits.
-        const double low = bhp_samples[sign_change_index + 1];
-        const double high = bhp_samples[sign_change_index];
-        const int max_iteration = 100;
-        const double bhp_tolerance = 0.01 * unit::barsa;
-        int iteration = 0;
-        if (low == high) {
-            // We are in the high flow regime where the bhp_samples
-            // are all equal to the bhp_limit.
-            assert(low == controls.bhp_limit);
-            deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
-                                    "Robust bhp(thp) solve failed for well " + name());
-            return std::optional<double>();
-        }
-        try {
-            const double solved_bhp = RegulaFalsiBisection<WarnAndContinueOnError>::
-                    solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
-#ifdef EXTRA_THP_DEBUGGING
-            OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(solved_bhp)
-                          + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
-#endif // EXTRA_THP_DEBUGGING
-            return solved_bhp;
-        }
-        catch (...) {
-            deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
-                                    "Robust bhp(thp) solve failed for well " + name());
-            return std::optional<double>();
-        }
-
+        return WellThpLimitSolver::computeBhpAtThpLimit(name(), /*is_producer*/ false, table.getFloAxis(),
+                                                        controls.bhp_limit, thp_limit, /*alq*/ 0.0,
+                                                        frates, flo, fbhp_samples, fbhp,
+                                                        thpLimitCacheEntry(controls.vfp_table_number,
+                                                                           controls.bhp_limit,
+                                                                           thpLimitCacheKey()),
+                                                        deferred_logger);
     }
 
 
@@ -3691,22 +3444,11 @@ namespace Opm
 
 
     template<typename TypeTag>
-    double
+    std::vector<double>
     MultisegmentWell<TypeTag>::
-    maxPerfPress(const Simulator& ebos_simulator) const
+    thpLimitCacheKey() const
     {
-        double max_pressure = 0.0;
-        const int nseg = numberOfSegments();
-        for (int seg = 0; seg < nseg; ++seg) {
-            for (const int perf : segment_perforations_[seg]) {
-                const int cell_idx = well_cells_[perf];
-                const auto& int_quants = *(ebos_simulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
-                const auto& fs = int_quants.fluidState();
-                double pressure_cell = fs.pressure(FluidSystem::oilPhaseIdx).value();
-                max_pressure = std::max(max_pressure, pressure_cell);
-            }
-        }
-        return max_pressure;
+        return { getRefDensity() };
     }
 
 
@@ -22,6 +22,8 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
 
+#include <cassert>
+
 namespace Dune
 {
 #if HAVE_MPI
@@ -195,6 +197,11 @@ void CommunicateAboveBelow::clear()
     current_indices_ = {};
     interface_.free();
     communicator_.free();
+    partial_sum_send_indices_.clear();
+    partial_sum_sizes_.clear();
+    partial_sum_displ_.clear();
+    partial_sum_map_received_.clear();
+    partial_sum_local_to_global_.clear();
 #endif
     num_local_perfs_ = 0;
 }
@@ -225,11 +232,68 @@ int CommunicateAboveBelow::endReset()
         using ToSet = Dune::AllSet<Attribute>;
         interface_.build(remote_indices_, FromSet(), ToSet());
         communicator_.build<double*>(interface_);
+        setupPartialSum();
     }
 #endif
     return num_local_perfs_;
 }
 
+void CommunicateAboveBelow::setupPartialSum()
+{
+#if HAVE_MPI
+    // The global index used in the index set current_indices
+    // is the index of the perforation in ECL Schedule definition.
+    // This is assumed to give the topological order that is used
+    // when doing the partial sum. The ordering does not change until
+    // the next reset, so we compute the communication layout and the
+    // permutation once here instead of on every partial sum.
+    using GlobalIndex = typename IndexSet::IndexPair::GlobalIndex;
+    partial_sum_send_indices_.clear();
+    std::vector<GlobalIndex> my_indices;
+    for (const auto& pair: current_indices_)
+    {
+        if (pair.local().attribute() == owner)
+        {
+            partial_sum_send_indices_.push_back(pair.local());
+            my_indices.push_back(pair.global());
+        }
+    }
+    partial_sum_sizes_.assign(comm_.size(), 0);
+    partial_sum_displ_.assign(comm_.size() + 1, 0);
+    int mySize = my_indices.size();
+    comm_.allgather(&mySize, 1, partial_sum_sizes_.data());
+    std::partial_sum(partial_sum_sizes_.begin(), partial_sum_sizes_.end(),
+                     partial_sum_displ_.begin()+1);
+    std::vector<GlobalIndex> global_indices(partial_sum_displ_.back());
+    comm_.allgatherv(my_indices.data(), my_indices.size(), global_indices.data(),
+                     partial_sum_sizes_.data(), partial_sum_displ_.data());
+
+    // sort the complete range to get the correct ordering
+    partial_sum_map_received_.resize(global_indices.size());
+    std::iota(partial_sum_map_received_.begin(), partial_sum_map_received_.end(), 0);
+    std::sort(partial_sum_map_received_.begin(), partial_sum_map_received_.end(),
+              [&global_indices](int i1, int i2)
+              { return global_indices[i1] < global_indices[i2]; });
+    std::vector<GlobalIndex> sorted_indices(global_indices.size());
+    std::transform(partial_sum_map_received_.begin(), partial_sum_map_received_.end(),
+                   sorted_indices.begin(),
+                   [&global_indices](int i) { return global_indices[i]; });
+
+    // position of all local perforations in the sorted range
+    partial_sum_local_to_global_.clear();
+    partial_sum_local_to_global_.reserve(current_indices_.size());
+    for (const auto& pair: current_indices_)
+    {
+        auto pos = std::lower_bound(sorted_indices.begin(), sorted_indices.end(),
+                                    pair.global());
+        assert(pos != sorted_indices.end());
+        assert(*pos == pair.global());
+        partial_sum_local_to_global_.emplace_back(pair.local(),
+                                                  pos - sorted_indices.begin());
+    }
+#endif
+}
+
 struct CopyGatherScatter
 {
     static const double& gather(const double* a, std::size_t i)
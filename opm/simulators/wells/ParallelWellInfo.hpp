@@ -26,9 +26,12 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <iterator>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 namespace Opm
 {
@@ -120,48 +123,30 @@ public:
         else
         {
 #if HAVE_MPI
-            // The global index used in the index set current_indices
-            // is the index of the perforation in ECL Schedule definition.
-            // This is assumed to give the topological order that is used
-            // when doing the partial sum.
-            // allgather the index of the perforation in ECL schedule and the value.
+            // The layout of the communication and the ordering of the
+            // perforations by their index in the ECL schedule is set up
+            // once in endReset(). Here we only need to gather the values.
             using Value = typename std::iterator_traits<RAIterator>::value_type;
-            std::vector<int> sizes(comm_.size());
-            std::vector<int> displ(comm_.size() + 1, 0);
-            using GlobalIndex = typename IndexSet::IndexPair::GlobalIndex;
-            using Pair = std::pair<GlobalIndex,Value>;
-            std::vector<Pair> my_pairs;
-            my_pairs.reserve(current_indices_.size());
-            for (const auto& pair: current_indices_)
+            std::vector<Value> my_values;
+            my_values.reserve(partial_sum_send_indices_.size());
+            for (const int local : partial_sum_send_indices_)
             {
-                if (pair.local().attribute() == owner)
-                {
-                    my_pairs.emplace_back(pair.global(), begin[pair.local()]);
-                }
+                my_values.push_back(begin[local]);
             }
-            int mySize = my_pairs.size();
-            comm_.allgather(&mySize, 1, sizes.data());
-            std::partial_sum(sizes.begin(), sizes.end(), displ.begin()+1);
-            std::vector<Pair> global_pairs(displ.back());
-            comm_.allgatherv(my_pairs.data(), my_pairs.size(), global_pairs.data(), sizes.data(), displ.data());
-            // sort the complete range to get the correct ordering
-            std::sort(global_pairs.begin(), global_pairs.end(),
-                      [](const Pair& p1, const Pair& p2){ return p1.first < p2.first; } );
-            std::vector<Value> sums(global_pairs.size());
-            std::transform(global_pairs.begin(), global_pairs.end(), sums.begin(),
-                           [](const Pair& p) { return p.second; });
+            std::vector<Value> received(partial_sum_displ_.back());
+            comm_.allgatherv(my_values.data(), my_values.size(), received.data(),
+                             const_cast<int*>(partial_sum_sizes_.data()),
+                             const_cast<int*>(partial_sum_displ_.data()));
+            // order by the ecl index, which gives the topological order
+            // used when doing the partial sum.
+            std::vector<Value> sums(received.size());
+            std::transform(partial_sum_map_received_.begin(), partial_sum_map_received_.end(),
+                           sums.begin(), [&received](int i) { return received[i]; });
             std::partial_sum(sums.begin(), sums.end(),sums.begin());
-            // assign the values (both ranges are sorted by the ecl index)
-            auto global_pair = global_pairs.begin();
-            for (const auto& pair: current_indices_)
+            // assign the values to all local perforations
+            for (const auto& [local, global_pos] : partial_sum_local_to_global_)
             {
-                global_pair = std::lower_bound(global_pair, global_pairs.end(),
-                                               pair.global(),
-                                               [](const Pair& val1, const GlobalIndex& val2)
-                                               { return val1.first < val2; });
-                assert(global_pair != global_pairs.end());
-                assert(global_pair->first == pair.global());
-                begin[pair.local()] = sums[global_pair - global_pairs.begin()];
+                begin[local] = sums[global_pos];
             }
 #else
             OPM_THROW(std::logic_error, "In a sequential run the size of the communicator should be 1!");
@@ -174,6 +159,9 @@ public:
 
     int numLocalPerfs() const;
 private:
+    /// \brief Set up the communication layout used by partialSumPerfValues
+    void setupPartialSum();
+
     Communication comm_;
     /// \brief Mapping of the local well index to ecl index
     IndexSet current_indices_;
@@ -183,6 +171,19 @@ private:
     RI remote_indices_;
     Dune::Interface interface_;
     Dune::BufferedCommunicator communicator_;
+    /// \brief Local indices of the owned perforations, in the order they are sent
+    ///        by partialSumPerfValues
+    std::vector<int> partial_sum_send_indices_;
+    /// \brief sizes for allgatherv in partialSumPerfValues
+    std::vector<int> partial_sum_sizes_;
+    /// \brief displacement for allgatherv in partialSumPerfValues
+    std::vector<int> partial_sum_displ_;
+    /// \brief Position in the received data for each perforation in ascending
+    ///        order of the ecl index.
+    std::vector<int> partial_sum_map_received_;
+    /// \brief Pairs of local index and position in ascending order of the ecl index
+    ///        for all local perforations
+    std::vector<std::pair<int,int>> partial_sum_local_to_global_;
 #endif
     std::size_t num_local_perfs_{};
 };
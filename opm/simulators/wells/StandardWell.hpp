@@ -649,6 +649,10 @@ namespace Opm
                                                       const SummaryState& summary_state,
                                                       DeferredLogger& deferred_logger) const;
 
+        // Explicit quantities of the well that the inflow relation depends
+        // on, used to validate the cached thp limit solutions.
+        std::vector<double> thpLimitCacheKey() const;
+
     };
 
 }
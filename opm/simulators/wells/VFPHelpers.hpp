@@ -23,7 +23,9 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
@@ -169,6 +171,60 @@ struct InterpData {
 
 
 
+/**
+ * Intervals found by the last lookup on each axis of a production table.
+ * They are used as hints for the next lookup, see findInterpData().
+ */
+struct VFPProdHint {
+    int flo = 0;
+    int thp = 0;
+    int wfr = 0;
+    int gfr = 0;
+    int alq = 0;
+};
+
+
+
+
+
+
+/**
+ * Helper function to fill in the interpolation data for the interval
+ * [values[interval], values[interval+1]] of an axis with at least two values.
+ */
+inline InterpData interpDataInInterval(const double value, const std::vector<double>& values, const int interval) {
+    InterpData retval;
+    retval.ind_[0] = interval;
+    retval.ind_[1] = interval+1;
+
+    const double start = values[retval.ind_[0]];
+    const double end   = values[retval.ind_[1]];
+
+    //Find interpolation ratio
+    if (end > start) {
+        //FIXME: Possible source for floating point error here if value and floor are large,
+        //but very close to each other
+        retval.inv_dist_ = 1.0 / (end-start);
+        retval.factor_ = (value-start) * retval.inv_dist_;
+    }
+    else {
+        retval.inv_dist_ = 0.0;
+        retval.factor_ = 0.0;
+    }
+
+    // Disallow extrapolation with higher factor than 3.0.
+    // The factor 3.0 has been chosen because it works well
+    // with certain testcases, and may not be optimal.
+    if (retval.factor_ > 3.0) {
+        retval.factor_ = 3.0;
+    }
+
+    return retval;
+}
+
+
+
+
 
 
 /**
@@ -178,67 +234,72 @@ struct InterpData {
  *  @return Data required to find the interpolated value
  */
 inline InterpData findInterpData(const double& value_in, const std::vector<double>& values) {
-    InterpData retval;
-
     const int nvalues = values.size();
 
+    //If we only have one value in our vector, return that
+    if (nvalues == 1) {
+        return InterpData();
+    }
+
     // chopping the value to be zero, which means we do not
     // extrapolate the table towards nagative ranges
     const double value = value_in < 0.? 0. : value_in;
 
-    //If we only have one value in our vector, return that
-    if (values.size() == 1) {
-        retval.ind_[0] = 0;
-        retval.ind_[1] = 0;
-        retval.inv_dist_ = 0.0;
-        retval.factor_ = 0.0;
+    int interval = 0;
+    //If value is less than all values, use first interval
+    if (value < values.front()) {
+        interval = 0;
+    }
+    //If value is greater than all values, use last interval
+    else if (value >= values.back()) {
+        interval = nvalues-2;
     }
-    // Else search in the vector
     else {
-        //If value is less than all values, use first interval
-        if (value < values.front()) {
-            retval.ind_[0] = 0;
-            retval.ind_[1] = 1;
-        }
-        //If value is greater than all values, use last interval
-        else if (value >= values.back()) {
-            retval.ind_[0] = nvalues-2;
-            retval.ind_[1] = nvalues-1;
-        }
-        else {
-            //Search internal intervals
-            for (int i=1; i<nvalues; ++i) {
-                if (values[i] >= value) {
-                    retval.ind_[0] = i-1;
-                    retval.ind_[1] = i;
-                    break;
-                }
-            }
-        }
+        //Search internal intervals for the first element greater than
+        //or equal to value. The axis is sorted, so use binary search.
+        const auto upper = std::lower_bound(values.begin() + 1, values.end(), value);
+        interval = std::distance(values.begin(), upper) - 1;
+    }
 
-        const double start = values[retval.ind_[0]];
-        const double end   = values[retval.ind_[1]];
+    return interpDataInInterval(value, values, interval);
+}
 
-        //Find interpolation ratio
-        if (end > start) {
-            //FIXME: Possible source for floating point error here if value and floor are large,
-            //but very close to each other
-            retval.inv_dist_ = 1.0 / (end-start);
-            retval.factor_ = (value-start) * retval.inv_dist_;
-        }
-        else {
-            retval.inv_dist_ = 0.0;
-            retval.factor_ = 0.0;
-        }
+
+
+
+
+
+/**
+ * Same as findInterpData(value_in, values), but the interval given by
+ * hint is tried before searching the axis, and hint is updated to the
+ * interval found. Repeated lookups of nearby values, such as the
+ * iterations of a thp solve, then mostly skip the search.
+ *  @param value_in Value to find in values
+ *  @param values Sorted list of values to search for value in.
+ *  @param hint Interval index from the previous lookup on this axis.
+ *  @return Data required to find the interpolated value
+ */
+inline InterpData findInterpData(const double& value_in, const std::vector<double>& values, int& hint) {
+    const int nvalues = values.size();
+    if (nvalues == 1) {
+        hint = 0;
+        return InterpData();
     }
 
-    // Disallow extrapolation with higher factor than 3.0.
-    // The factor 3.0 has been chosen because it works well
-    // with certain testcases, and may not be optimal.
-    if (retval.factor_ > 3.0) {
-        retval.factor_ = 3.0;
+    const double value = value_in < 0.? 0. : value_in;
+
+    // Use the hinted interval if it is the one the search would select.
+    if (hint >= 0 && hint <= nvalues-2) {
+        const bool hint_matches = (value >= values.back())
+            ? hint == nvalues-2
+            : values[hint+1] >= value && (hint == 0 || values[hint] < value);
+        if (hint_matches) {
+            return interpDataInInterval(value, values, hint);
+        }
     }
 
+    InterpData retval = findInterpData(value, values);
+    hint = retval.ind_[0];
     return retval;
 }
 
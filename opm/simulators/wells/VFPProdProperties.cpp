@@ -94,6 +94,59 @@ double VFPProdProperties::bhp(int table_id,
 }
 
 
+detail::VFPEvaluation VFPProdProperties::bhpWithHint(int table_id,
+                                                     const double& aqua,
+                                                     const double& liquid,
+                                                     const double& vapour,
+                                                     const double& thp_arg,
+                                                     const double& alq,
+                                                     detail::VFPProdHint& hint) const {
+    const VFPProdTable& table = detail::getTable(m_tables, table_id);
+
+    const double flo = detail::getFlo(table, aqua, liquid, vapour);
+    const double wfr = detail::getWFR(table, aqua, liquid, vapour);
+    const double gfr = detail::getGFR(table, aqua, liquid, vapour);
+
+    //Recall that flo is negative in Opm, so switch sign.
+    const auto flo_i = detail::findInterpData(-flo, table.getFloAxis(), hint.flo);
+    const auto thp_i = detail::findInterpData( thp_arg, table.getTHPAxis(), hint.thp);
+    const auto wfr_i = detail::findInterpData( wfr, table.getWFRAxis(), hint.wfr);
+    const auto gfr_i = detail::findInterpData( gfr, table.getGFRAxis(), hint.gfr);
+    const auto alq_i = detail::findInterpData( alq, table.getALQAxis(), hint.alq);
+
+    return detail::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+}
+
+
+std::vector<double> VFPProdProperties::bhps(int table_id,
+                                            const std::vector<std::vector<double>>& rates,
+                                            const double thp_arg,
+                                            const double alq,
+                                            detail::VFPProdHint& hint) const {
+    const VFPProdTable& table = detail::getTable(m_tables, table_id);
+
+    // thp and alq are the same for all entries.
+    const auto thp_i = detail::findInterpData( thp_arg, table.getTHPAxis(), hint.thp);
+    const auto alq_i = detail::findInterpData( alq, table.getALQAxis(), hint.alq);
+
+    std::vector<double> bhp_values(rates.size(), 0.0);
+    for (std::size_t i = 0; i < rates.size(); ++i) {
+        const auto& r = rates[i];
+        const double flo = detail::getFlo(table, r[BlackoilPhases::Aqua], r[BlackoilPhases::Liquid], r[BlackoilPhases::Vapour]);
+        const double wfr = detail::getWFR(table, r[BlackoilPhases::Aqua], r[BlackoilPhases::Liquid], r[BlackoilPhases::Vapour]);
+        const double gfr = detail::getGFR(table, r[BlackoilPhases::Aqua], r[BlackoilPhases::Liquid], r[BlackoilPhases::Vapour]);
+
+        const auto flo_i = detail::findInterpData(-flo, table.getFloAxis(), hint.flo);
+        const auto wfr_i = detail::findInterpData( wfr, table.getWFRAxis(), hint.wfr);
+        const auto gfr_i = detail::findInterpData( gfr, table.getGFRAxis(), hint.gfr);
+
+        bhp_values[i] = detail::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i).value;
+    }
+
+    return bhp_values;
+}
+
+
 const VFPProdTable& VFPProdProperties::getTable(const int table_id) const {
     return detail::getTable(m_tables, table_id);
 }
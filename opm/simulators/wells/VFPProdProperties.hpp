@@ -112,6 +112,46 @@ public:
             const double& thp,
             const double& alq) const;
 
+    /**
+     * Linear interpolation of bhp as a function of the input parameters,
+     * starting the axis lookups from the intervals of a previous call.
+     * @param table_id Table number to use
+     * @param aqua Water phase
+     * @param liquid Oil phase
+     * @param vapour Gas phase
+     * @param thp Tubing head pressure
+     * @param alq Artificial lift or other parameter
+     * @param hint Intervals of the previous lookup, updated on return
+     *
+     * @return The interpolated bottom hole pressure with its derivatives.
+     */
+    detail::VFPEvaluation bhpWithHint(int table_id,
+                                      const double& aqua,
+                                      const double& liquid,
+                                      const double& vapour,
+                                      const double& thp,
+                                      const double& alq,
+                                      detail::VFPProdHint& hint) const;
+
+    /**
+     * Linear interpolation of bhp for a set of phase rates, with the tubing
+     * head pressure and artificial lift held fixed. The thp and alq lookups
+     * are done once, and the remaining lookups start from the intervals of
+     * the previous entry.
+     * @param table_id Table number to use
+     * @param rates Water, oil and gas rates, one entry per evaluation
+     * @param thp Tubing head pressure
+     * @param alq Artificial lift or other parameter
+     * @param hint Intervals of the previous lookup, updated on return
+     *
+     * @return The bottom hole pressures, one per entry in rates.
+     */
+    std::vector<double> bhps(int table_id,
+                             const std::vector<std::vector<double>>& rates,
+                             const double thp,
+                             const double alq,
+                             detail::VFPProdHint& hint) const;
+
     /**
      * Linear interpolation of thp as a function of the input parameters
      * @param table_id Table number to use
@@ -254,6 +254,21 @@ void WellInterfaceGeneric::setGuideRate(const GuideRate* guide_rate_arg)
     guide_rate_ = guide_rate_arg;
 }
 
+void WellInterfaceGeneric::setThpLimitCache(WellThpLimitCache* thp_limit_cache_arg)
+{
+    thp_limit_cache_ = thp_limit_cache_arg;
+}
+
+WellThpLimitCache::Entry* WellInterfaceGeneric::thpLimitCacheEntry(const int table_id,
+                                                                   const double bhp_limit,
+                                                                   const std::vector<double>& well_key) const
+{
+    if (!thp_limit_cache_) {
+        return nullptr;
+    }
+    return &thp_limit_cache_->entry(name(), isProducer(), table_id, bhp_limit, well_key);
+}
+
 void WellInterfaceGeneric::setWellEfficiencyFactor(const double efficiency_factor)
 {
     well_efficiency_factor_ = efficiency_factor;
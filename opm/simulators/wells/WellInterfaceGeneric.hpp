@@ -25,6 +25,8 @@
 #define OPM_WELLINTERFACE_GENERIC_HEADER_INCLUDED
 
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
+#include <opm/simulators/wells/VFPHelpers.hpp>
+#include <opm/simulators/wells/WellThpLimitSolver.hpp>
 
 #include <map>
 #include <optional>
@@ -72,6 +74,9 @@ public:
     /// Index of well in the wells struct and wellState
     int indexOfWell() const;
 
+    /// Information about the processes sharing the well.
+    const ParallelWellInfo& parallelWellInfo() const { return parallel_well_info_; }
+
     const Well& wellEcl() const;
     const PhaseUsage& phaseUsage() const;
 
@@ -86,6 +91,7 @@ public:
 
     void setVFPProperties(const VFPProperties* vfp_properties_arg);
     void setGuideRate(const GuideRate* guide_rate_arg);
+    void setThpLimitCache(WellThpLimitCache* thp_limit_cache_arg);
     void setWellEfficiencyFactor(const double efficiency_factor);
     void setRepRadiusPerfLength(const std::vector<int>& cartesian_to_compressed);
     void setWsolvent(const double wsolvent);
@@ -108,6 +114,14 @@ public:
     }
 
 protected:
+
+    // Entry of this well in the cache of the bhp(thp) solves, or nullptr
+    // if there is no cache. The well_key holds the well quantities the
+    // inflow relation is computed from.
+    WellThpLimitCache::Entry* thpLimitCacheEntry(const int table_id,
+                                                 const double bhp_limit,
+                                                 const std::vector<double>& well_key) const;
+
     // whether a well is specified with a non-zero and valid VFP table number
     bool isVFPActive(DeferredLogger& deferred_logger) const;
 
@@ -246,7 +260,12 @@ protected:
 
     double well_efficiency_factor_;
     const VFPProperties* vfp_properties_;
+    // intervals of the last production VFP table lookup for this well,
+    // used to start the lookups of the next bhp(thp) evaluation
+    mutable detail::VFPProdHint vfp_prod_hint_;
     const GuideRate* guide_rate_;
+    // samples and solutions of the bhp(thp) solves, owned by the well model
+    WellThpLimitCache* thp_limit_cache_ = nullptr;
 };
 
 }
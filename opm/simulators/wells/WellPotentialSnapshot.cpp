@@ -0,0 +1,55 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/wells/WellPotentialSnapshot.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace Opm {
+
+bool canReuseWellPotentials(const WellPotentialSnapshot& last,
+                            const WellPotentialSnapshot& current,
+                            const double tolerance)
+{
+    if (last.control_mode != current.control_mode ||
+        last.stopped != current.stopped ||
+        last.operable != current.operable ||
+        last.limits != current.limits ||
+        last.cell_pressures.size() != current.cell_pressures.size() ||
+        last.cell_mobilities.size() != current.cell_mobilities.size()) {
+        return false;
+    }
+
+    auto relativeChange = [](const double prev, const double curr) {
+        return std::abs(curr - prev) / std::max(std::abs(prev), 1.0e-20);
+    };
+    for (std::size_t i = 0; i < current.cell_pressures.size(); ++i) {
+        if (relativeChange(last.cell_pressures[i], current.cell_pressures[i]) > tolerance ||
+            relativeChange(last.cell_mobilities[i], current.cell_mobilities[i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Opm
@@ -0,0 +1,54 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELLPOTENTIALSNAPSHOT_HEADER_INCLUDED
+#define OPM_WELLPOTENTIALSNAPSHOT_HEADER_INCLUDED
+
+#include <vector>
+
+namespace Opm {
+
+    /// State of the connection cells, the controls and the status of a
+    /// well when its potentials were last computed, used to decide
+    /// whether they can be reused.
+    struct WellPotentialSnapshot
+    {
+        std::vector<double> cell_pressures;
+        std::vector<double> cell_mobilities;
+        int control_mode{};
+        /// BHP, THP and rate limits of the active controls.
+        std::vector<double> limits;
+        bool stopped{false};
+        bool operable{true};
+        std::vector<double> potentials;
+    };
+
+    /// Whether the potentials stored in \p last are still valid for a well
+    /// now in the state \p current.
+    ///
+    /// This requires the control mode, the status and all limits to be
+    /// unchanged, and the relative change of the pressure and the total
+    /// mobility in each connection cell to be at most \p tolerance.
+    bool canReuseWellPotentials(const WellPotentialSnapshot& last,
+                                const WellPotentialSnapshot& current,
+                                const double tolerance);
+
+} // namespace Opm
+
+#endif // OPM_WELLPOTENTIALSNAPSHOT_HEADER_INCLUDED
@@ -0,0 +1,464 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/wells/WellThpLimitSolver.hpp>
+
+#include <opm/parser/eclipse/Units/Units.hpp>
+#include <opm/simulators/utils/DeferredLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Brent's method for a zero of f in the bracket [a, b], where fa = f(a)
+// and fb = f(b) have opposite signs. It stops when |f| <= f_tol or when
+// the bracket is narrower than x_tol.
+std::optional<double> brentSolve(const std::function<double(double)>& f,
+                                 double a, double fa,
+                                 double b, double fb,
+                                 const double x_tol,
+                                 const double f_tol,
+                                 const int max_iteration)
+{
+    if (fa * fb > 0.0) {
+        return std::nullopt;
+    }
+    if (std::fabs(fa) <= f_tol) {
+        return a;
+    }
+
+    double c = b;
+    double fc = fb;
+    double d = b - a;
+    double e = d;
+    for (int iteration = 0; iteration < max_iteration; ++iteration) {
+        if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0)) {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        const double tol = 2.0 * std::numeric_limits<double>::epsilon() * std::fabs(b) + 0.5 * x_tol;
+        const double xm = 0.5 * (c - b);
+        if (std::fabs(xm) <= tol || std::fabs(fb) <= f_tol) {
+            return b;
+        }
+
+        if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+            // Secant step if we only have two distinct points, inverse
+            // quadratic interpolation otherwise.
+            const double s = fb / fa;
+            double p = 0.0;
+            double q = 0.0;
+            if (a == c) {
+                p = 2.0 * xm * s;
+                q = 1.0 - s;
+            } else {
+                const double qa = fa / fc;
+                const double r = fb / fc;
+                p = s * (2.0 * xm * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) {
+                q = -q;
+            }
+            p = std::fabs(p);
+            // Only accept the interpolation if it stays well inside the
+            // bracket and shrinks fast enough, otherwise bisect.
+            if (2.0 * p < std::min(3.0 * xm * q - std::fabs(tol * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = xm;
+                e = d;
+            }
+        } else {
+            d = xm;
+            e = d;
+        }
+
+        a = b;
+        fa = fb;
+        b += std::fabs(d) > tol ? d : (xm > 0.0 ? tol : -tol);
+        fb = f(b);
+    }
+
+    return std::nullopt;
+}
+
+} // anonymous namespace
+
+namespace Opm
+{
+
+void WellThpLimitCache::newReservoirState(const int report_step)
+{
+    if (report_step != report_step_) {
+        entries_.clear();
+        report_step_ = report_step;
+        return;
+    }
+    for (auto& keyed_entry : entries_) {
+        Entry& entry = keyed_entry.second.second;
+        entry.samples.reset();
+        entry.solutions.clear();
+    }
+}
+
+WellThpLimitCache::Entry&
+WellThpLimitCache::entry(const std::string& well_name,
+                         const bool is_producer,
+                         const int table_id,
+                         const double bhp_limit,
+                         const std::vector<double>& well_key)
+{
+    auto [it, inserted] = entries_.try_emplace(well_name, Key{is_producer, table_id, bhp_limit, well_key}, Entry{});
+    auto& [stored_key, entry] = it->second;
+    if (inserted) {
+        return entry;
+    }
+    if (stored_key.is_producer != is_producer ||
+        stored_key.table_id != table_id ||
+        stored_key.bhp_limit != bhp_limit) {
+        stored_key = Key{is_producer, table_id, bhp_limit, well_key};
+        entry = Entry{};
+    } else if (stored_key.well_key != well_key) {
+        // Same well setup in another state, keep the start value.
+        stored_key.well_key = well_key;
+        entry.samples.reset();
+        entry.solutions.clear();
+    }
+    return entry;
+}
+
+namespace WellThpLimitSolver
+{
+
+InflowSamples computeInflowSamples(const std::vector<double>& flo_axis,
+                                   const double bhp_limit,
+                                   const bool is_producer,
+                                   const RatesFunction& frates,
+                                   const FloFunction& flo,
+                                   const std::string& well_name,
+                                   DeferredLogger& deferred_logger)
+{
+    // The VFP code expects production flo values to be negative, while
+    // the table axis holds their magnitude.
+    const double flo_sign = is_producer ? -1.0 : 1.0;
+
+    InflowSamples samples;
+
+    // Get the flo samples, add extra samples at low rates and bhp
+    // limit point if necessary.
+    std::vector<double>& flo_samples = samples.flo;
+    flo_samples = flo_axis;
+    if (flo_samples[0] > 0.0) {
+        const double f0 = flo_samples[0];
+        flo_samples.insert(flo_samples.begin(), { f0/20.0, f0/10.0, f0/5.0, f0/2.0 });
+    }
+    const std::vector<double> rates_bhp_limit = frates(bhp_limit);
+    const double flo_bhp_limit = flo_sign * flo(rates_bhp_limit);
+    if (flo_samples.back() < flo_bhp_limit) {
+        flo_samples.push_back(flo_bhp_limit);
+    }
+    for (double& x : flo_samples) {
+        x *= flo_sign;
+    }
+    samples.flo_bhp_limit = flo_bhp_limit;
+
+    // TODO: replace hardcoded low/high limits.
+    const double low = 10.0 * unit::barsa;
+    const double high = (is_producer ? 600.0 : 800.0) * unit::barsa;
+    const int max_iteration = 50;
+    const double flo_tolerance = 1e-6 * std::fabs(flo_samples.back());
+    const double bhp_tolerance = 1e-6 * unit::barsa;
+
+    // The rates at the ends of the search interval are the same for all
+    // flo samples, only evaluate them once.
+    std::optional<std::vector<double>> rates_low;
+    std::optional<std::vector<double>> rates_high;
+
+    // Find bhp values for inflow relation corresponding to flo samples.
+    std::vector<double>& bhp_samples = samples.bhp;
+    for (const double flo_sample : flo_samples) {
+        if (flo_sign * flo_sample > flo_bhp_limit) {
+            // We would have to go beyond the bhp limit to obtain a
+            // flow of this magnitude. We associate all such flows
+            // with simply the bhp limit. The first one
+            // encountered is considered valid, the rest not. They
+            // are therefore skipped.
+            bhp_samples.push_back(bhp_limit);
+            samples.rates.push_back(rates_bhp_limit);
+            break;
+        }
+
+        // Remember the rates evaluated during the solve, the rates at the
+        // solution are stored with the sample.
+        std::vector<std::pair<double, std::vector<double>>> evaluated;
+        auto eq = [&flo, &frates, &evaluated, flo_sample](double bhp) {
+            evaluated.emplace_back(bhp, frates(bhp));
+            return flo(evaluated.back().second) - flo_sample;
+        };
+        auto eq_at = [&flo, flo_sample](const std::vector<double>& rates) {
+            return flo(rates) - flo_sample;
+        };
+
+        if (!rates_low) {
+            rates_low = frates(low);
+        }
+        if (!rates_high) {
+            rates_high = frates(high);
+        }
+
+        // The flo samples are increasing in magnitude, so the bhp solved
+        // for the previous sample bounds the solution from above for
+        // producers and from below for injectors. Try this tighter
+        // bracket first. The rates at the previous sample are known, so
+        // the bracket costs no extra rate evaluations.
+        std::optional<double> solved_bhp;
+        if (!bhp_samples.empty() && bhp_samples.back() > low && bhp_samples.back() < high) {
+            const double prev = bhp_samples.back();
+            const double f_prev = eq_at(samples.rates.back());
+            solved_bhp = is_producer
+                ? brentSolve(eq, low, eq_at(*rates_low), prev, f_prev,
+                             bhp_tolerance, flo_tolerance, max_iteration)
+                : brentSolve(eq, prev, f_prev, high, eq_at(*rates_high),
+                             bhp_tolerance, flo_tolerance, max_iteration);
+        }
+        if (!solved_bhp) {
+            solved_bhp = brentSolve(eq, low, eq_at(*rates_low), high, eq_at(*rates_high),
+                                    bhp_tolerance, flo_tolerance, max_iteration);
+        }
+
+        if (solved_bhp) {
+            bhp_samples.push_back(*solved_bhp);
+            const auto at_solution = std::find_if(evaluated.begin(), evaluated.end(),
+                                                  [bhp = *solved_bhp](const auto& e) { return e.first == bhp; });
+            if (at_solution != evaluated.end()) {
+                samples.rates.push_back(at_solution->second);
+            } else if (*solved_bhp == low) {
+                samples.rates.push_back(*rates_low);
+            } else if (*solved_bhp == high) {
+                samples.rates.push_back(*rates_high);
+            } else {
+                samples.rates.push_back(frates(*solved_bhp));
+            }
+        } else {
+            // Use previous value (or the zero rate end of the interval
+            // if at start) if we failed.
+            if (bhp_samples.empty()) {
+                bhp_samples.push_back(is_producer ? high : low);
+                samples.rates.push_back(is_producer ? *rates_high : *rates_low);
+            } else {
+                bhp_samples.push_back(bhp_samples.back());
+                samples.rates.push_back(samples.rates.back());
+            }
+            deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_EXTRACT_SAMPLES",
+                                    "Robust bhp(thp) solve failed extracting bhp values at flo samples for well " + well_name);
+        }
+    }
+
+    return samples;
+}
+
+
+
+std::optional<double> solveBhpAtThpLimit(const InflowSamples& samples,
+                                         const std::vector<double>& fbhp_samples,
+                                         const BhpFunction& fbhp,
+                                         const RatesFunction& frates,
+                                         const std::optional<double>& bhp_guess,
+                                         const std::string& well_name,
+                                         DeferredLogger& deferred_logger)
+{
+    const std::vector<double>& bhp_samples = samples.bhp;
+    const int num_samples = bhp_samples.size(); // Note that this can be smaller than samples.flo.size()
+// #define EXTRA_THP_DEBUGGING
+#ifdef EXTRA_THP_DEBUGGING
+    std::string dbgmsg;
+    dbgmsg += "flo: ";
+    for (int ii = 0; ii < num_samples; ++ii) {
+        dbgmsg += "  " + std::to_string(samples.flo[ii]);
+    }
+    dbgmsg += "\nbhp: ";
+    for (int ii = 0; ii < num_samples; ++ii) {
+        dbgmsg += "  " + std::to_string(bhp_samples[ii]);
+    }
+    dbgmsg += "\nfbhp: ";
+    for (int ii = 0; ii < num_samples; ++ii) {
+        dbgmsg += "  " + std::to_string(fbhp_samples[ii]);
+    }
+    deferred_logger.debug(dbgmsg);
+#endif // EXTRA_THP_DEBUGGING
+
+    // Look for sign changes for the (fbhp_samples - bhp_samples) piecewise linear curve.
+    int sign_change_index = -1;
+    for (int ii = 0; ii < num_samples - 1; ++ii) {
+        const double curr = fbhp_samples[ii] - bhp_samples[ii];
+        const double next = fbhp_samples[ii + 1] - bhp_samples[ii + 1];
+        if (curr * next < 0.0) {
+            // Sign change in the [ii, ii + 1] interval.
+            sign_change_index = ii; // May overwrite, thereby choosing the highest-flo solution.
+        }
+    }
+
+    // Handle the no solution case.
+    if (sign_change_index == -1) {
+        return std::nullopt;
+    }
+
+    if (bhp_samples[sign_change_index] == bhp_samples[sign_change_index + 1]) {
+        // We are in the high flow regime where the bhp_samples
+        // are all equal to the bhp_limit.
+        deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
+                                "Robust bhp(thp) solve failed for well " + well_name);
+        return std::nullopt;
+    }
+
+    // The samples are exact evaluations of the equation, so they give
+    // the bracket and its end values without further rate evaluations.
+    auto eq = [&fbhp, &frates](double bhp) {
+        return fbhp(frates(bhp)) - bhp;
+    };
+    double low = bhp_samples[sign_change_index];
+    double high = bhp_samples[sign_change_index + 1];
+    double eq_low = fbhp_samples[sign_change_index] - low;
+    double eq_high = fbhp_samples[sign_change_index + 1] - high;
+    if (low > high) {
+        std::swap(low, high);
+        std::swap(eq_low, eq_high);
+    }
+    const int max_iteration = 50;
+    const double bhp_tolerance = 0.01 * unit::barsa;
+
+    // Newton steps, starting from the guess if inside the bracket and
+    // from the zero of the sample interpolation otherwise. The slope of
+    // the samples is used as derivative until two iterates are available.
+    double slope = (eq_high - eq_low) / (high - low);
+    double bhp = (bhp_guess && *bhp_guess > low && *bhp_guess < high)
+        ? *bhp_guess : low - eq_low / slope;
+    std::optional<double> prev_bhp;
+    double prev_eq = 0.0;
+    int iteration = 0;
+    while (iteration < max_iteration) {
+        const double eq_bhp = eq(bhp);
+        ++iteration;
+        if (eq_bhp == 0.0) {
+            return bhp;
+        }
+        if ((eq_bhp < 0.0) == (eq_low < 0.0)) {
+            low = bhp;
+            eq_low = eq_bhp;
+        } else {
+            high = bhp;
+            eq_high = eq_bhp;
+        }
+        if (prev_bhp) {
+            if (std::fabs(eq_bhp) > 0.5 * std::fabs(prev_eq)) {
+                // Not converging fast enough.
+                break;
+            }
+            const double secant = (eq_bhp - prev_eq) / (bhp - *prev_bhp);
+            if (std::isfinite(secant) && secant != 0.0) {
+                slope = secant;
+            }
+        }
+        const double next = bhp - eq_bhp / slope;
+        if (!(next > low && next < high)) {
+            break;
+        }
+        if (std::fabs(next - bhp) < bhp_tolerance) {
+            return next;
+        }
+        prev_bhp = bhp;
+        prev_eq = eq_bhp;
+        bhp = next;
+    }
+
+    // Fall back to Brent's method in what remains of the bracket.
+    const auto solved_bhp = brentSolve(eq, low, eq_low, high, eq_high,
+                                       bhp_tolerance, 0.0, max_iteration - iteration);
+    if (!solved_bhp) {
+        deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
+                                "Robust bhp(thp) solve failed for well " + well_name);
+    }
+#ifdef EXTRA_THP_DEBUGGING
+    else {
+        deferred_logger.debug("*****    " + well_name + "    solved_bhp = " + std::to_string(*solved_bhp)
+                              + "    flo_bhp_limit = " + std::to_string(samples.flo_bhp_limit));
+    }
+#endif // EXTRA_THP_DEBUGGING
+    return solved_bhp;
+}
+
+
+
+std::optional<double> computeBhpAtThpLimit(const std::string& well_name,
+                                           const bool is_producer,
+                                           const std::vector<double>& flo_axis,
+                                           const double bhp_limit,
+                                           const double thp_limit,
+                                           const double alq,
+                                           const RatesFunction& frates,
+                                           const FloFunction& flo,
+                                           const BhpSamplesFunction& fbhp_samples,
+                                           const BhpFunction& fbhp,
+                                           WellThpLimitCache::Entry* cache_entry,
+                                           DeferredLogger& deferred_logger)
+{
+    WellThpLimitCache::Entry local_entry;
+    WellThpLimitCache::Entry& entry = cache_entry ? *cache_entry : local_entry;
+
+    for (const auto& solution : entry.solutions) {
+        if (solution.thp_limit == thp_limit && solution.alq == alq) {
+            return solution.bhp;
+        }
+    }
+
+    if (!entry.samples) {
+        entry.samples = computeInflowSamples(flo_axis, bhp_limit, is_producer,
+                                             frates, flo, well_name, deferred_logger);
+    }
+
+    const std::vector<double> fbhp_values = fbhp_samples(entry.samples->rates);
+    const auto bhp = solveBhpAtThpLimit(*entry.samples, fbhp_values, fbhp, frates,
+                                        entry.last_bhp, well_name, deferred_logger);
+    if (bhp) {
+        entry.last_bhp = bhp;
+    }
+    entry.solutions.push_back({thp_limit, alq, bhp});
+    return bhp;
+}
+
+} // namespace WellThpLimitSolver
+
+} // namespace Opm
@@ -0,0 +1,163 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELLTHPLIMITSOLVER_HEADER_INCLUDED
+#define OPM_WELLTHPLIMITSOLVER_HEADER_INCLUDED
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+class DeferredLogger;
+
+/// Piecewise linear approximation of the inverse inflow relation of a
+/// well: the bhp values and the well rates at the flo sample points of
+/// its VFP table. It does not depend on the thp limit or the ALQ value,
+/// so it can be reused for several solves as long as the reservoir state
+/// is unchanged.
+struct InflowSamples
+{
+    /// Flo values, negative for producers as elsewhere in Opm.
+    std::vector<double> flo;
+    /// Bhp giving each flo value, can be shorter than flo.
+    std::vector<double> bhp;
+    /// Water, oil and gas rates at each bhp value.
+    std::vector<std::vector<double>> rates;
+    /// Magnitude of the flo value at the bhp limit.
+    double flo_bhp_limit = 0.0;
+};
+
+/// Inflow samples and bhp(thp) solutions of the wells in a report step,
+/// shared by the operability checks, the well potentials and gas lift.
+/// The samples and solutions are only valid for the reservoir state and
+/// the explicit well quantities they were computed with, so
+/// newReservoirState() must be called whenever the former changes, and
+/// the latter are part of the key of each entry.
+class WellThpLimitCache
+{
+public:
+    struct Entry
+    {
+        struct Solution
+        {
+            double thp_limit;
+            double alq;
+            std::optional<double> bhp;
+        };
+
+        std::optional<InflowSamples> samples;
+        std::vector<Solution> solutions;
+        /// Last bhp solved for the well, kept over state changes within
+        /// a report step as start value for the next solve.
+        std::optional<double> last_bhp;
+    };
+
+    /// Discard the samples and solutions of all wells. The start values
+    /// are kept unless the report step has changed.
+    void newReservoirState(const int report_step);
+
+    /// Entry of a well for the current state. The samples and solutions
+    /// of the entry are cleared if the table, the bhp limit or the
+    /// quantities in \p well_key differ from the ones they were
+    /// computed with.
+    Entry& entry(const std::string& well_name,
+                 const bool is_producer,
+                 const int table_id,
+                 const double bhp_limit,
+                 const std::vector<double>& well_key);
+
+private:
+    struct Key
+    {
+        bool is_producer;
+        int table_id;
+        double bhp_limit;
+        std::vector<double> well_key;
+    };
+
+    int report_step_ = -1;
+    std::map<std::string, std::pair<Key, Entry>> entries_;
+};
+
+namespace WellThpLimitSolver
+{
+
+    /// Well rates (water, oil, gas) at a given bhp.
+    using RatesFunction = std::function<std::vector<double>(const double)>;
+    /// VFP flo value of a set of well rates.
+    using FloFunction = std::function<double(const std::vector<double>&)>;
+    /// Bhp from the VFP table, corrected to the well reference depth, for
+    /// each of a set of well rates.
+    using BhpSamplesFunction = std::function<std::vector<double>(const std::vector<std::vector<double>>&)>;
+    /// Bhp from the VFP table, corrected to the well reference depth, for
+    /// a set of well rates.
+    using BhpFunction = std::function<double(const std::vector<double>&)>;
+
+    /// Sample the inverse inflow relation at the flo values of a VFP
+    /// table, with extra samples at low rates and at the bhp limit.
+    InflowSamples computeInflowSamples(const std::vector<double>& flo_axis,
+                                       const double bhp_limit,
+                                       const bool is_producer,
+                                       const RatesFunction& frates,
+                                       const FloFunction& flo,
+                                       const std::string& well_name,
+                                       DeferredLogger& deferred_logger);
+
+    /// Solve fbhp(frates(bhp)) = bhp for bhp, picking the solution with
+    /// the highest rate if there are two.
+    ///
+    /// The samples give the bracket of the solution. Inside it, Newton
+    /// steps are taken from \p bhp_guess, or from the linear
+    /// interpolation of the samples, with the derivative estimated from
+    /// the samples and then from the previous iterates. If these steps
+    /// leave the bracket or do not converge fast enough, Brent's method
+    /// is used on the remaining bracket.
+    std::optional<double> solveBhpAtThpLimit(const InflowSamples& samples,
+                                             const std::vector<double>& fbhp_samples,
+                                             const BhpFunction& fbhp,
+                                             const RatesFunction& frates,
+                                             const std::optional<double>& bhp_guess,
+                                             const std::string& well_name,
+                                             DeferredLogger& deferred_logger);
+
+    /// Bhp at the thp limit of a well, reusing the samples and solutions
+    /// of \p cache_entry when given.
+    std::optional<double> computeBhpAtThpLimit(const std::string& well_name,
+                                               const bool is_producer,
+                                               const std::vector<double>& flo_axis,
+                                               const double bhp_limit,
+                                               const double thp_limit,
+                                               const double alq,
+                                               const RatesFunction& frates,
+                                               const FloFunction& flo,
+                                               const BhpSamplesFunction& fbhp_samples,
+                                               const BhpFunction& fbhp,
+                                               WellThpLimitCache::Entry* cache_entry,
+                                               DeferredLogger& deferred_logger);
+
+} // namespace WellThpLimitSolver
+
+} // namespace Opm
+
+#endif // OPM_WELLTHPLIMITSOLVER_HEADER_INCLUDED
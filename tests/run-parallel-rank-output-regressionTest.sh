@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# This performs a serial and a parallel run for a simulator, where the
+# parallel run writes the cell data per rank, then compares the summary
+# files from the two runs and checks that the per rank files are written.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+ABS_TOL="$5"
+REL_TOL="$6"
+COMPARE_ECL_COMMAND="$7"
+EXE_NAME="${8}"
+shift 8
+TEST_ARGS="$@"
+
+NP=4
+
+rm -Rf ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}
+cd ${RESULT_PATH}
+${BINPATH}/${EXE_NAME} ${TEST_ARGS} --output-dir=${RESULT_PATH}
+
+test $? -eq 0 || exit 1
+mkdir mpi
+cd mpi
+mpirun -np ${NP} ${BINPATH}/${EXE_NAME} ${TEST_ARGS} --ecl-output-cell-data-per-rank=true --output-dir=${RESULT_PATH}/mpi
+test $? -eq 0 || exit 1
+cd ..
+
+ecode=0
+echo "=== Executing comparison for summary file ==="
+${COMPARE_ECL_COMMAND} -t SMRY -R ${RESULT_PATH}/${FILENAME} ${RESULT_PATH}/mpi/${FILENAME} ${ABS_TOL} ${REL_TOL}
+if [ $? -ne 0 ]
+then
+  ecode=1
+  ${COMPARE_ECL_COMMAND} -t SMRY -a -R ${RESULT_PATH}/${FILENAME} ${RESULT_PATH}/mpi/${FILENAME} ${ABS_TOL} ${REL_TOL}
+fi
+
+echo "=== Checking the per rank output files ==="
+for FILE in ${FILENAME}-RANKS.INDEX $(seq -f "${FILENAME}-RANK%g.UNRST" 0 $((NP - 1)))
+do
+  if [ ! -s ${RESULT_PATH}/mpi/${FILE} ]
+  then
+    echo "Missing output file ${FILE}"
+    ecode=1
+  fi
+done
+
+exit $ecode
@@ -0,0 +1,167 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestComponentSweepSolver
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/ComponentSweepSolver.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using Matrix = Opm::ComponentSweepMatrix;
+using Vector = Opm::ComponentSweepVector;
+
+// Upwind transport matrix: each entry (i, j, v) with i != j is the
+// off-diagonal coupling of row i to row j, and every row gets the
+// diagonal given.
+Matrix makeMatrix(const int n,
+                  const double diagonal,
+                  const std::vector<std::tuple<int, int, double>>& couplings)
+{
+    Matrix M(n, n, 3, 0.4, Matrix::implicit);
+    for (int i = 0; i < n; ++i) {
+        M.entry(i, i) = diagonal;
+    }
+    for (const auto& [i, j, v] : couplings) {
+        M.entry(i, j) = v;
+    }
+    M.compress();
+    return M;
+}
+
+std::vector<Vector> rightHandSides(const int n)
+{
+    std::vector<Vector> b(2, Vector(n));
+    for (int i = 0; i < n; ++i) {
+        b[0][i] = 1.0 + i;
+        b[1][i] = (i % 2 == 0) ? 2.0 : -0.5;
+    }
+    return b;
+}
+
+// Solve with a dense direct solver and compare with the sweep.
+void checkAgainstDirectSolve(const Matrix& M,
+                             const Opm::ComponentOrdering& ordering,
+                             const std::vector<Vector>& b)
+{
+    const int n = M.N();
+    Dune::DynamicMatrix<double> A(n, n, 0.0);
+    for (auto rowIt = M.begin(); rowIt != M.end(); ++rowIt) {
+        for (auto colIt = rowIt->begin(); colIt != rowIt->end(); ++colIt) {
+            A[rowIt.index()][colIt.index()] = (*colIt)[0][0];
+        }
+    }
+
+    std::vector<Vector> x(b.size(), Vector(n));
+    Opm::componentSweepSolve(M, ordering, {0, 1}, x, b);
+
+    for (std::size_t k = 0; k < b.size(); ++k) {
+        Dune::DynamicVector<double> rhs(n);
+        Dune::DynamicVector<double> expected(n);
+        for (int i = 0; i < n; ++i) {
+            rhs[i] = b[k][i][0];
+        }
+        A.solve(expected, rhs);
+        for (int i = 0; i < n; ++i) {
+            BOOST_CHECK_CLOSE(x[k][i][0], expected[i], 1.0e-10);
+        }
+    }
+}
+
+std::vector<std::size_t> componentSizes(const Opm::ComponentOrdering& ordering)
+{
+    std::vector<std::size_t> sizes;
+    for (std::size_t c = 0; c + 1 < ordering.componentStart.size(); ++c) {
+        sizes.push_back(ordering.componentStart[c + 1] - ordering.componentStart[c]);
+    }
+    return sizes;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Chain)
+{
+    // Flow from row 4 down to row 0, each row depends on the next one.
+    const auto M = makeMatrix(5, 2.0, {{0, 1, -1.0}, {1, 2, -1.0}, {2, 3, -1.0}, {3, 4, -1.0}});
+
+    Opm::ComponentOrdering ordering;
+    BOOST_REQUIRE(Opm::findComponentOrdering(M, 1, ordering));
+    BOOST_CHECK_EQUAL(componentSizes(ordering).size(), 5u);
+    const std::vector<unsigned> expectedOrder {4, 3, 2, 1, 0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(ordering.order.begin(), ordering.order.end(),
+                                  expectedOrder.begin(), expectedOrder.end());
+
+    checkAgainstDirectSolve(M, ordering, rightHandSides(5));
+}
+
+BOOST_AUTO_TEST_CASE(TwoCycle)
+{
+    // Rows 0 and 1 depend on each other.
+    const auto M = makeMatrix(2, 3.0, {{0, 1, -1.0}, {1, 0, -2.0}});
+
+    Opm::ComponentOrdering ordering;
+    BOOST_CHECK(!Opm::findComponentOrdering(M, 1, ordering));
+    BOOST_REQUIRE(Opm::findComponentOrdering(M, 2, ordering));
+    const std::vector<std::size_t> expectedSizes {2};
+    const auto sizes = componentSizes(ordering);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sizes.begin(), sizes.end(),
+                                  expectedSizes.begin(), expectedSizes.end());
+
+    checkAgainstDirectSolve(M, ordering, rightHandSides(2));
+}
+
+BOOST_AUTO_TEST_CASE(Mixed)
+{
+    // Row 5 feeds the cycle 2 -> 3 -> 4 -> 2, which feeds row 1, which
+    // feeds row 0. Row 6 is isolated, and the zero coupling of row 0 to
+    // row 6 is ignored.
+    const auto M = makeMatrix(7, 4.0, {{0, 1, -1.0}, {0, 6, 0.0},
+                                       {1, 2, -1.0}, {1, 4, -0.5},
+                                       {2, 4, -1.0}, {3, 2, -1.0}, {4, 3, -1.5},
+                                       {3, 5, -1.0}});
+
+    Opm::ComponentOrdering ordering;
+    BOOST_CHECK(!Opm::findComponentOrdering(M, 2, ordering));
+    BOOST_REQUIRE(Opm::findComponentOrdering(M, 3, ordering));
+    BOOST_CHECK_EQUAL(ordering.order.size(), 7u);
+
+    // Every component comes after the components it depends on.
+    std::vector<std::size_t> component(7);
+    for (std::size_t c = 0; c + 1 < ordering.componentStart.size(); ++c) {
+        for (auto i = ordering.componentStart[c]; i < ordering.componentStart[c + 1]; ++i) {
+            component[ordering.order[i]] = c;
+        }
+    }
+    BOOST_CHECK(component[2] == component[3] && component[3] == component[4]);
+    BOOST_CHECK(component[5] < component[3]);
+    BOOST_CHECK(component[2] < component[1]);
+    BOOST_CHECK(component[1] < component[0]);
+    BOOST_CHECK_EQUAL(componentSizes(ordering).size(), 5u);
+
+    checkAgainstDirectSolve(M, ordering, rightHandSides(7));
+}
@@ -84,7 +84,10 @@ BOOST_AUTO_TEST_CASE(deferredlogger)
     deferred_logger.note("tagme", "note 3");
     deferred_logger.note("tagme", "note 3");
 
+    BOOST_CHECK_EQUAL(deferred_logger.numMessages(), 15U);
+
     deferred_logger.logMessages();
+    BOOST_CHECK_EQUAL(deferred_logger.numMessages(), 0U);
 
     auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
     BOOST_CHECK_EQUAL( 1 , counter->numMessages(Log::MessageType::Warning) );
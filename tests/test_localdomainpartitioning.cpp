@@ -0,0 +1,199 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestLocalDomainPartitioning
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/LocalDomainPartitioning.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+// the face neighbours of the cells of an nx-by-ny Cartesian grid
+std::vector<std::vector<int>> cartesianNeighbours(const int nx, const int ny)
+{
+    std::vector<std::vector<int>> neighbours(nx*ny);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            auto& nb = neighbours[j*nx + i];
+            if (i > 0)      nb.push_back(j*nx + i - 1);
+            if (i < nx - 1) nb.push_back(j*nx + i + 1);
+            if (j > 0)      nb.push_back((j - 1)*nx + i);
+            if (j < ny - 1) nb.push_back((j + 1)*nx + i);
+        }
+    }
+    return neighbours;
+}
+
+int numDomains(const std::vector<int>& cellDomain)
+{
+    return *std::max_element(cellDomain.begin(), cellDomain.end()) + 1;
+}
+
+// whether the cells of each subdomain are connected within the subdomain
+bool domainsConnected(const std::vector<std::vector<int>>& neighbours,
+                      const std::vector<int>& cellDomain)
+{
+    const int nd = numDomains(cellDomain);
+    for (int d = 0; d < nd; ++d) {
+        const auto first = std::find(cellDomain.begin(), cellDomain.end(), d);
+        if (first == cellDomain.end())
+            return false;
+
+        std::vector<char> visited(cellDomain.size(), 0);
+        std::vector<int> queue(1, first - cellDomain.begin());
+        visited[queue[0]] = 1;
+        for (std::size_t pos = 0; pos < queue.size(); ++pos) {
+            for (const int nb : neighbours[queue[pos]]) {
+                if (cellDomain[nb] == d && !visited[nb]) {
+                    visited[nb] = 1;
+                    queue.push_back(nb);
+                }
+            }
+        }
+        if (queue.size() != static_cast<std::size_t>(std::count(cellDomain.begin(), cellDomain.end(), d)))
+            return false;
+    }
+    return true;
+}
+
+// whether no two neighbouring subdomains have the same color
+bool validColoring(const std::vector<std::vector<int>>& neighbours,
+                   const std::vector<int>& cellDomain,
+                   const std::vector<int>& colors)
+{
+    for (std::size_t cell = 0; cell < neighbours.size(); ++cell) {
+        for (const int nb : neighbours[cell]) {
+            const int d1 = cellDomain[cell];
+            const int d2 = cellDomain[nb];
+            if (d1 >= 0 && d2 >= 0 && d1 != d2 && colors[d1] == colors[d2])
+                return false;
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Partitioning)
+
+BOOST_AUTO_TEST_CASE(AllCellsEligible)
+{
+    const auto neighbours = cartesianNeighbours(8, 8);
+    const std::vector<char> eligible(64, 1);
+    const auto cellDomain = Opm::partitionLocalDomains(neighbours, eligible, 4);
+
+    BOOST_CHECK(std::none_of(cellDomain.begin(), cellDomain.end(),
+                             [](const int d) { return d < 0; }));
+    BOOST_CHECK_GE(numDomains(cellDomain), 4);
+    for (int d = 0; d < numDomains(cellDomain); ++d)
+        BOOST_CHECK_LE(std::count(cellDomain.begin(), cellDomain.end(), d), 16);
+    BOOST_CHECK(domainsConnected(neighbours, cellDomain));
+}
+
+BOOST_AUTO_TEST_CASE(IneligibleCells)
+{
+    // the outer ring of cells is left out, e.g. as the process boundary
+    const int n = 6;
+    const auto neighbours = cartesianNeighbours(n, n);
+    std::vector<char> eligible(n*n, 1);
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            if (i == 0 || j == 0 || i == n - 1 || j == n - 1)
+                eligible[j*n + i] = 0;
+        }
+    }
+
+    const auto cellDomain = Opm::partitionLocalDomains(neighbours, eligible, 2);
+    for (int cell = 0; cell < n*n; ++cell)
+        BOOST_CHECK_EQUAL(cellDomain[cell] >= 0, eligible[cell] == 1);
+    BOOST_CHECK(domainsConnected(neighbours, cellDomain));
+}
+
+BOOST_AUTO_TEST_CASE(DisconnectedCells)
+{
+    // two separate chains of three cells cannot be one subdomain
+    const std::vector<std::vector<int>> neighbours = {
+        {1}, {0, 2}, {1}, {4}, {3, 5}, {4}
+    };
+    const std::vector<char> eligible(6, 1);
+    const auto cellDomain = Opm::partitionLocalDomains(neighbours, eligible, 1);
+
+    BOOST_CHECK_EQUAL(numDomains(cellDomain), 2);
+    BOOST_CHECK(domainsConnected(neighbours, cellDomain));
+}
+
+BOOST_AUTO_TEST_CASE(MoreDomainsThanCells)
+{
+    const auto neighbours = cartesianNeighbours(2, 2);
+    const std::vector<char> eligible = {1, 0, 1, 1};
+    const auto cellDomain = Opm::partitionLocalDomains(neighbours, eligible, 10);
+
+    BOOST_CHECK_EQUAL(numDomains(cellDomain), 3);
+    BOOST_CHECK_EQUAL(cellDomain[1], -1);
+}
+
+BOOST_AUTO_TEST_CASE(NoDomains)
+{
+    const auto neighbours = cartesianNeighbours(3, 3);
+    const auto cellDomain = Opm::partitionLocalDomains(neighbours, std::vector<char>(9, 1), 0);
+    BOOST_CHECK(std::all_of(cellDomain.begin(), cellDomain.end(),
+                            [](const int d) { return d == -1; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Partitioning
+
+BOOST_AUTO_TEST_SUITE(Coloring)
+
+BOOST_AUTO_TEST_CASE(Chain)
+{
+    // a chain of subdomains alternates between two colors
+    const int n = 10;
+    const auto neighbours = cartesianNeighbours(n, 1);
+    std::vector<int> cellDomain(n);
+    for (int cell = 0; cell < n; ++cell)
+        cellDomain[cell] = cell/2;
+
+    const auto colors = Opm::colorLocalDomains(neighbours, cellDomain, n/2);
+    BOOST_REQUIRE_EQUAL(colors.size(), static_cast<std::size_t>(n/2));
+    for (int d = 0; d < n/2; ++d)
+        BOOST_CHECK_EQUAL(colors[d], d % 2);
+}
+
+BOOST_AUTO_TEST_CASE(PartitionedGrid)
+{
+    const auto neighbours = cartesianNeighbours(12, 12);
+    std::vector<char> eligible(144, 1);
+    eligible[0] = eligible[77] = 0;
+    const auto cellDomain = Opm::partitionLocalDomains(neighbours, eligible, 9);
+    const int nd = numDomains(cellDomain);
+    const auto colors = Opm::colorLocalDomains(neighbours, cellDomain, nd);
+
+    BOOST_REQUIRE_EQUAL(colors.size(), static_cast<std::size_t>(nd));
+    BOOST_CHECK(validColoring(neighbours, cellDomain, colors));
+    BOOST_CHECK_LT(*std::max_element(colors.begin(), colors.end()), nd);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Coloring
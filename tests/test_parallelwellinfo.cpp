@@ -403,6 +403,47 @@ BOOST_AUTO_TEST_CASE(PartialSumParallel)
     }
 }
 
+BOOST_AUTO_TEST_CASE(PartialSumParallelRepeated)
+{
+    // The communication layout is set up once in endReset and reused
+    // for every partial sum until the next reset.
+    auto comm = Communication(Dune::MPIHelper::getCommunicator());
+
+    Opm::CommunicateAboveBelow commAboveBelow{ comm };
+    auto globalEclIndex = createGlobalEclIndex(comm);
+    std::vector<double> globalCurrent(globalEclIndex.size());
+    initRandomNumbers(std::begin(globalCurrent), std::end(globalCurrent),
+                      Communication(comm));
+
+    auto localCurrent = populateCommAbove(commAboveBelow, comm,
+                                          globalEclIndex, globalCurrent);
+
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        auto globalPartialSum = globalCurrent;
+        std::partial_sum(std::begin(globalPartialSum), std::end(globalPartialSum),
+                         std::begin(globalPartialSum));
+        auto localSum = localCurrent;
+
+        commAboveBelow.partialSumPerfValues(std::begin(localSum), std::end(localSum));
+
+        for (std::size_t i = 0; i < localSum.size(); ++i)
+        {
+            auto gi = comm.rank() + comm.size() * i;
+            BOOST_CHECK(localSum[i]==globalPartialSum[gi]);
+        }
+        // change the values but keep the layout
+        for (auto& val : globalCurrent)
+        {
+            val *= 2.0;
+        }
+        for (auto& val : localCurrent)
+        {
+            val *= 2.0;
+        }
+    }
+}
+
 void testGlobalPerfFactoryParallel(int num_component, bool local_consecutive = false)
 {
     auto comm = Communication(Dune::MPIHelper::getCommunicator());
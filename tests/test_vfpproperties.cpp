@@ -98,6 +98,37 @@ BOOST_AUTO_TEST_CASE(findInterpData)
     BOOST_CHECK_EQUAL(eval5.factor_, 1.0);
 }
 
+BOOST_AUTO_TEST_CASE(findInterpDataWithHint)
+{
+    std::vector<double> values = {1, 5, 7, 9, 11, 15};
+    // Sweep up and down the axis, with jumps, repeated values, exact
+    // axis values and values outside the axis.
+    std::vector<double> lookups = {6.0, 6.5, 7.0, 7.0, 8.0, 12.0, 9.0, -1.0, 0.5, 1.0,
+                                   15.0, 19.0, 14.0, 2.0, 11.0, 5.0, 4.9, 100.0};
+
+    for (int start_hint : {-1, 0, 3, 4, 10}) {
+        int hint = start_hint;
+        for (double value : lookups) {
+            const auto ref = Opm::detail::findInterpData(value, values);
+            const auto eval = Opm::detail::findInterpData(value, values, hint);
+            BOOST_CHECK_EQUAL(eval.ind_[0], ref.ind_[0]);
+            BOOST_CHECK_EQUAL(eval.ind_[1], ref.ind_[1]);
+            BOOST_CHECK_EQUAL(eval.factor_, ref.factor_);
+            BOOST_CHECK_EQUAL(eval.inv_dist_, ref.inv_dist_);
+            BOOST_CHECK_EQUAL(hint, ref.ind_[0]);
+        }
+    }
+
+    // A single value axis
+    std::vector<double> single = {3.0};
+    int hint = 2;
+    const auto eval = Opm::detail::findInterpData(4.0, single, hint);
+    BOOST_CHECK_EQUAL(eval.ind_[0], 0);
+    BOOST_CHECK_EQUAL(eval.ind_[1], 0);
+    BOOST_CHECK_EQUAL(eval.factor_, 0.0);
+    BOOST_CHECK_EQUAL(hint, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // HelperTests
 
 
@@ -514,6 +545,40 @@ BOOST_AUTO_TEST_CASE(InterpolateOne)
 
 
 
+/**
+ * Test that the hinted and the batched evaluations give the same bhp
+ * values as the plain evaluation, also when extrapolating.
+ */
+BOOST_AUTO_TEST_CASE(BhpWithHintMatchesBhp)
+{
+    fillDataRandom();
+    initProperties();
+
+    const double thp = 0.3;
+    const double alq = 0.6;
+    std::vector<std::vector<double>> rates;
+    for (int i=0; i<=25; ++i) {
+        // Producers have negative rates in Opm
+        const double scale = 1.2 * i / 20.0;
+        rates.push_back({-0.7 * scale, -0.4 * scale, -(0.1 + 0.8 * i / 25.0) * scale});
+    }
+
+    Opm::detail::VFPProdHint hint;
+    const auto bhps = properties->bhps(1, rates, thp, alq, hint);
+    BOOST_REQUIRE_EQUAL(bhps.size(), rates.size());
+
+    Opm::detail::VFPProdHint single_hint;
+    for (size_t i=0; i<rates.size(); ++i) {
+        const auto& r = rates[i];
+        const double reference = properties->bhp(1, r[0], r[1], r[2], thp, alq);
+        BOOST_CHECK_SMALL(bhps[i] - reference, max_d_tol);
+
+        const auto eval = properties->bhpWithHint(1, r[0], r[1], r[2], thp, alq, single_hint);
+        BOOST_CHECK_SMALL(eval.value - reference, max_d_tol);
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(THPToBHPAndBackPlane)
 {
     fillDataPlane();
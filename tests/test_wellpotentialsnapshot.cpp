@@ -0,0 +1,119 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestWellPotentialSnapshot
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/WellPotentialSnapshot.hpp>
+
+namespace {
+
+Opm::WellPotentialSnapshot makeSnapshot()
+{
+    Opm::WellPotentialSnapshot snapshot;
+    snapshot.cell_pressures = {200.0e5, 210.0e5, 220.0e5};
+    snapshot.cell_mobilities = {1.0e3, 2.0e3, 3.0e3};
+    snapshot.control_mode = 1;
+    snapshot.limits = {100.0e5, 0.0, 1.0e-2, 2.0e-2};
+    snapshot.potentials = {1.0e-2, 2.0e-3, 0.0};
+    return snapshot;
+}
+
+constexpr double tolerance = 1.0e-3;
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Reuse)
+
+BOOST_AUTO_TEST_CASE(Unchanged)
+{
+    const auto last = makeSnapshot();
+    BOOST_CHECK(Opm::canReuseWellPotentials(last, makeSnapshot(), tolerance));
+}
+
+BOOST_AUTO_TEST_CASE(SmallCellChange)
+{
+    const auto last = makeSnapshot();
+    auto current = makeSnapshot();
+    current.cell_pressures[1] *= 1.0 + 0.5*tolerance;
+    current.cell_mobilities[2] *= 1.0 - 0.5*tolerance;
+    BOOST_CHECK(Opm::canReuseWellPotentials(last, current, tolerance));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Reuse
+
+BOOST_AUTO_TEST_SUITE(Invalidation)
+
+BOOST_AUTO_TEST_CASE(PressureChange)
+{
+    const auto last = makeSnapshot();
+    auto current = makeSnapshot();
+    current.cell_pressures[0] *= 1.0 + 2.0*tolerance;
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, current, tolerance));
+}
+
+BOOST_AUTO_TEST_CASE(MobilityChange)
+{
+    const auto last = makeSnapshot();
+    auto current = makeSnapshot();
+    current.cell_mobilities[1] *= 1.0 - 2.0*tolerance;
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, current, tolerance));
+}
+
+BOOST_AUTO_TEST_CASE(ControlChange)
+{
+    const auto last = makeSnapshot();
+    auto current = makeSnapshot();
+    current.control_mode = 2;
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, current, tolerance));
+}
+
+BOOST_AUTO_TEST_CASE(LimitChange)
+{
+    const auto last = makeSnapshot();
+    auto current = makeSnapshot();
+    current.limits[2] *= 1.0 + 0.5*tolerance;
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, current, tolerance));
+}
+
+BOOST_AUTO_TEST_CASE(StatusChange)
+{
+    const auto last = makeSnapshot();
+    auto stopped = makeSnapshot();
+    stopped.stopped = true;
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, stopped, tolerance));
+
+    auto inoperable = makeSnapshot();
+    inoperable.operable = false;
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, inoperable, tolerance));
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionChange)
+{
+    const auto last = makeSnapshot();
+    auto current = makeSnapshot();
+    current.cell_pressures.pop_back();
+    current.cell_mobilities.pop_back();
+    BOOST_CHECK(!Opm::canReuseWellPotentials(last, current, tolerance));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Invalidation
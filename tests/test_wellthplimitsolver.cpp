@@ -0,0 +1,248 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestWellThpLimitSolver
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/WellThpLimitSolver.hpp>
+
+#include <opm/simulators/utils/DeferredLogger.hpp>
+
+#include <cmath>
+
+namespace {
+
+constexpr double bar = 1.0e5;
+constexpr double bhp_tolerance = 0.02 * bar;
+
+// A well with a linear inflow relation in a reservoir at 250 bar, the
+// rate in units of the flo axis is the pressure difference in bar.
+// Rates are ordered water, oil, gas.
+struct SyntheticWell
+{
+    bool is_producer = true;
+    int rate_evaluations = 0;
+    // VFP bhp as a function of the flo magnitude.
+    std::function<double(double)> vfp;
+
+    std::vector<double> rates(const double bhp)
+    {
+        ++rate_evaluations;
+        const double p_res = 250.0 * bar;
+        if (is_producer) {
+            return {0.0, -std::max(p_res - bhp, 0.0) / bar, 0.0};
+        }
+        return {std::max(bhp - p_res, 0.0) / bar, 0.0, 0.0};
+    }
+
+    double flo(const std::vector<double>& r) const
+    {
+        return is_producer ? r[1] : r[0];
+    }
+
+    std::optional<double> solve(Opm::WellThpLimitCache* cache,
+                                const double bhp_limit,
+                                const double alq = 0.0,
+                                const int table_id = 1,
+                                const std::vector<double>& well_key = {})
+    {
+        const std::vector<double> flo_axis = is_producer
+            ? std::vector<double>{5.0, 20.0, 50.0, 100.0, 150.0, 200.0, 300.0}
+            : std::vector<double>{5.0, 20.0, 50.0, 100.0};
+        auto frates = [this](const double bhp) { return rates(bhp); };
+        auto fflo = [this](const std::vector<double>& r) { return flo(r); };
+        auto fbhp = [this](const std::vector<double>& r) { return vfp(std::fabs(flo(r))); };
+        auto fbhp_samples = [&fbhp](const std::vector<std::vector<double>>& all_rates) {
+            std::vector<double> values;
+            for (const auto& r : all_rates) {
+                values.push_back(fbhp(r));
+            }
+            return values;
+        };
+        Opm::DeferredLogger logger;
+        auto* entry = cache ? &cache->entry("W", is_producer, table_id, bhp_limit, well_key) : nullptr;
+        return Opm::WellThpLimitSolver::computeBhpAtThpLimit("W", is_producer, flo_axis,
+                                                             bhp_limit, 0.0, alq, frates, fflo,
+                                                             fbhp_samples, fbhp, entry, logger);
+    }
+};
+
+// Largest root of f in [a, b] by bisection, with f(a) and f(b) of
+// opposite signs.
+double bisect(const std::function<double(double)>& f, double a, double b)
+{
+    double fa = f(a);
+    for (int i = 0; i < 200; ++i) {
+        const double m = 0.5 * (a + b);
+        const double fm = f(m);
+        if ((fm < 0.0) == (fa < 0.0)) {
+            a = m;
+            fa = fm;
+        } else {
+            b = m;
+        }
+    }
+    return 0.5 * (a + b);
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(Solve)
+
+BOOST_AUTO_TEST_CASE(ProducerSingleSolution)
+{
+    SyntheticWell well;
+    well.vfp = [](const double q) { return 50.0 * bar + 0.5 * bar * q; };
+    const auto bhp = well.solve(nullptr, 20.0 * bar);
+    BOOST_REQUIRE(bhp.has_value());
+    // bhp = 50 + 0.5 * (250 - bhp)
+    BOOST_CHECK_SMALL(*bhp - 175.0 / 1.5 * bar, bhp_tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(ProducerTwoSolutions)
+{
+    // Liquid loading gives a high bhp at low rates, so there is one
+    // solution at a low and one at a high rate.
+    SyntheticWell well;
+    well.vfp = [](const double q) { return (50.0 + 1500.0 / (q + 5.0) + 0.5 * q) * bar; };
+    const auto bhp = well.solve(nullptr, 20.0 * bar);
+    BOOST_REQUIRE(bhp.has_value());
+
+    // The solution with the highest rate, q = 250 - bhp.
+    auto g = [](const double q) { return 1.5 * q + 1500.0 / (q + 5.0) - 200.0; };
+    const double q_high = bisect(g, 20.0, 230.0);
+    BOOST_CHECK_SMALL(*bhp - (250.0 - q_high) * bar, bhp_tolerance);
+    const double q_low = bisect(g, 0.0, 20.0);
+    BOOST_CHECK(q_low < 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(ProducerNoSolution)
+{
+    // The tubing pressure loss is larger than the reservoir pressure.
+    SyntheticWell well;
+    well.vfp = [](const double q) { return 300.0 * bar + 0.5 * bar * q; };
+    BOOST_CHECK(!well.solve(nullptr, 20.0 * bar).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(Injector)
+{
+    SyntheticWell well;
+    well.is_producer = false;
+    well.vfp = [](const double q) { return 300.0 * bar - 0.2 * bar * q; };
+    const auto bhp = well.solve(nullptr, 500.0 * bar);
+    BOOST_REQUIRE(bhp.has_value());
+    // bhp = 300 - 0.2 * (bhp - 250)
+    BOOST_CHECK_SMALL(*bhp - 350.0 / 1.2 * bar, bhp_tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(NewtonFromGuess)
+{
+    SyntheticWell well;
+    well.vfp = [](const double q) { return (50.0 + 0.5 * q + 0.002 * q * q) * bar; };
+    Opm::WellThpLimitCache cache;
+    cache.newReservoirState(0);
+    const auto bhp = well.solve(&cache, 20.0 * bar);
+    BOOST_REQUIRE(bhp.has_value());
+    auto g = [](const double b) {
+        const double q = 250.0 - b;
+        return 50.0 + 0.5 * q + 0.002 * q * q - b;
+    };
+    BOOST_CHECK_SMALL(*bhp - bisect(g, 20.0, 250.0) * bar, bhp_tolerance);
+
+    // A new state with the same reservoir starts from the last solution.
+    cache.newReservoirState(0);
+    well.rate_evaluations = 0;
+    const auto resolved = well.solve(&cache, 20.0 * bar);
+    BOOST_REQUIRE(resolved.has_value());
+    BOOST_CHECK_SMALL(*resolved - *bhp, bhp_tolerance);
+
+    Opm::WellThpLimitCache cold_cache;
+    cold_cache.newReservoirState(0);
+    SyntheticWell cold_well = well;
+    cold_well.rate_evaluations = 0;
+    cold_well.solve(&cold_cache, 20.0 * bar);
+    BOOST_CHECK(well.rate_evaluations <= cold_well.rate_evaluations);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Cache)
+
+BOOST_AUTO_TEST_CASE(ReuseWithinState)
+{
+    SyntheticWell well;
+    well.vfp = [](const double q) { return 50.0 * bar + 0.5 * bar * q; };
+    Opm::WellThpLimitCache cache;
+    cache.newReservoirState(3);
+
+    const auto bhp = well.solve(&cache, 20.0 * bar);
+    BOOST_REQUIRE(bhp.has_value());
+
+    // The same solve is answered from the cache.
+    well.rate_evaluations = 0;
+    const auto cached = well.solve(&cache, 20.0 * bar);
+    BOOST_REQUIRE(cached.has_value());
+    BOOST_CHECK_EQUAL(*cached, *bhp);
+    BOOST_CHECK_EQUAL(well.rate_evaluations, 0);
+
+    // Another ALQ value reuses the samples and only costs the final solve.
+    const auto other_alq = well.solve(&cache, 20.0 * bar, 1.0);
+    BOOST_REQUIRE(other_alq.has_value());
+    BOOST_CHECK(well.rate_evaluations > 0);
+    BOOST_CHECK(well.rate_evaluations < 10);
+
+    // A new reservoir state needs new samples.
+    cache.newReservoirState(3);
+    well.rate_evaluations = 0;
+    well.solve(&cache, 20.0 * bar);
+    BOOST_CHECK(well.rate_evaluations > 10);
+
+    // So does another table.
+    well.rate_evaluations = 0;
+    well.solve(&cache, 20.0 * bar, 0.0, 2);
+    BOOST_CHECK(well.rate_evaluations > 10);
+
+    // And other explicit well quantities.
+    well.rate_evaluations = 0;
+    well.solve(&cache, 20.0 * bar, 0.0, 2, {1.0});
+    BOOST_CHECK(well.rate_evaluations > 10);
+    well.rate_evaluations = 0;
+    well.solve(&cache, 20.0 * bar, 0.0, 2, {1.0});
+    BOOST_CHECK_EQUAL(well.rate_evaluations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(NewReportStep)
+{
+    Opm::WellThpLimitCache cache;
+    cache.newReservoirState(0);
+    auto& entry = cache.entry("W", true, 1, 20.0 * bar, {});
+    entry.last_bhp = 100.0 * bar;
+
+    cache.newReservoirState(0);
+    BOOST_CHECK(cache.entry("W", true, 1, 20.0 * bar, {}).last_bhp.has_value());
+    BOOST_CHECK(cache.entry("W", true, 1, 20.0 * bar, {2.0}).last_bhp.has_value());
+
+    cache.newReservoirState(1);
+    BOOST_CHECK(!cache.entry("W", true, 1, 20.0 * bar, {2.0}).last_bhp.has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()